@@ -0,0 +1,515 @@
+#include "../game/game.h"
+#include "../game/game_state.h"
+#include "../game/board.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <new>
+
+using std::cout;
+using std::vector;
+using std::string;
+
+// Benchmark for the hint search and the board lookups it is built on
+// Boards are generated from a fixed seed so every run measures the same positions
+
+// Every heap allocation the benchmark makes, to check that a hint makes none
+static long long allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+// Build a random position the same way Game::generateNewBoard lays out objects
+GameState makeBoard(int rows, int cols, int numOfZombies, std::mt19937& rng)
+{
+    GameState state;
+    state.rows = rows;
+    state.cols = cols;
+    state.board.resize(rows, cols, ' ');
+
+    vector<pair<int,int>> coordinates;
+    for(int row = 0; row < rows; row++)
+    {
+        for(int col = 0; col < cols; col++)
+        {
+            if (row != rows/2 || col != cols/2) coordinates.push_back({row, col});
+        }
+    }
+    std::shuffle(coordinates.begin(), coordinates.end(), rng);
+    state.board.set(rows/2, cols/2, 'A');
+
+    int emptyCells = (int)coordinates.size() - numOfZombies;
+    string objects = string(emptyCells*10/100, 'r') + string(emptyCells*10/100, 'p') + string(emptyCells*5/100, 'h') + string(emptyCells*20/100, '*');
+    string arrows = "^v<>";
+
+    state.numberOfZombies = numOfZombies;
+    state.zombieAttributes.resize(numOfZombies, vector<int> (6));
+    int pointer = 0;
+    for(int i = 0; i < numOfZombies; i++, pointer++)
+    {
+        pair<int,int> coord = coordinates[pointer];
+        state.board.set(coord.first, coord.second, '1' + i);
+        state.zombieAttributes[i] = {i+1, coord.first, coord.second, 40 + 20 * (int)(rng() % 3), 10 + (int)(rng() % 20), 1 + (int)(rng() % 4)};
+    }
+    for(int i = 0; i < (int)objects.size(); i++, pointer++)
+    {
+        char object = objects[i] == '*' ? arrows[rng() % 4] : objects[i];
+        state.board.set(coordinates[pointer].first, coordinates[pointer].second, object);
+    }
+
+    // {row, col, health, attack, energy}
+    state.alienAttributes = {rows/2, cols/2, 100, 0, 5};
+    state.numberOfPlayerTurns = 0;
+    state.healthLost = 0;
+    state.attackGained = 0;
+    state.randomSeed = 0;
+    state.randomPosition = 0;
+    return state;
+}
+
+// A fixed position and the hint it must give
+// The alien stands on 'A' and zombie i on the digit i
+struct HintRegression
+{
+    string name;
+    vector<string> rows;
+    // {health, energy}
+    vector<int> alien;
+    // {health, attack, range} of every zombie, in ID order
+    vector<vector<int>> zombies;
+    // 0, 1, 2, 3 (U, D, L, R)
+    int direction;
+    // {row, col, direction} of every arrow to change, in the order Game::getHint gives them
+    vector<vector<int>> arrows;
+};
+
+// Boards with IDs swapped or rotated are the board before them with the zombies numbered differently,
+// a pod that picked among its tied closest zombies by ID would give a different hint for one of the two
+const vector<HintRegression> hintRegressions =
+{
+    {
+        "arrow chain into a zombie",
+        {
+            "         ",
+            "    >v   ",
+            "    A    ",
+            "         ",
+            "1    2   ",
+        },
+        {100, 0}, {{50, 10, 1}, {30, 10, 1}},
+        0, {},
+    },
+    {
+        "health rather than a rock next to a strong zombie",
+        {
+            "    2    ",
+            "    r    ",
+            "h   A   1",
+            "         ",
+            "  v   p  ",
+        },
+        {60, 2}, {{20, 5, 1}, {100, 30, 3}},
+        2, {},
+    },
+    {
+        "health when low",
+        {
+            "1   h    ",
+            "         ",
+            "  < A >  ",
+            "         ",
+            "    2   3",
+        },
+        {20, 1}, {{60, 10, 2}, {40, 15, 2}, {20, 5, 1}},
+        0, {},
+    },
+    {
+        "pod with two tied targets",
+        {
+            "  1      ",
+            "         ",
+            "    A p  ",
+            "         ",
+            "  2      ",
+        },
+        {50, 2}, {{10, 40, 3}, {60, 20, 3}},
+        3, {},
+    },
+    {
+        "pod with two tied targets, IDs swapped",
+        {
+            "  2      ",
+            "         ",
+            "    A p  ",
+            "         ",
+            "  1      ",
+        },
+        {50, 2}, {{60, 20, 3}, {10, 40, 3}},
+        3, {},
+    },
+    {
+        "pod with three tied targets",
+        {
+            "     3   ",
+            "  v      ",
+            "  < A p1 ",
+            "      h  ",
+            "     2 ^ ",
+        },
+        {80, 3}, {{10, 25, 2}, {50, 10, 2}, {10, 5, 4}},
+        2, {{2, 2, 0}},
+    },
+    {
+        "pod with three tied targets, IDs rotated",
+        {
+            "     2   ",
+            "  v      ",
+            "  < A p3 ",
+            "      h  ",
+            "     1 ^ ",
+        },
+        {80, 3}, {{50, 10, 2}, {10, 5, 4}, {10, 25, 2}},
+        2, {{2, 2, 0}},
+    },
+    {
+        "two pods, both tied",
+        {
+            " 1     2 ",
+            "    p    ",
+            "    A    ",
+            "    p    ",
+            " 3     4 ",
+        },
+        {100, 0}, {{20, 10, 2}, {10, 30, 2}, {10, 10, 2}, {20, 35, 2}},
+        1, {},
+    },
+    {
+        "pod that only pays off on the weak target",
+        {
+            "       ",
+            "1      ",
+            "  pA   ",
+            "      2",
+            "       ",
+        },
+        {50, 0}, {{10, 15, 1}, {60, 15, 1}},
+        1, {},
+    },
+    {
+        "pod that only pays off on the weak target, IDs swapped",
+        {
+            "       ",
+            "2      ",
+            "  pA   ",
+            "      1",
+            "       ",
+        },
+        {50, 0}, {{60, 15, 1}, {10, 15, 1}},
+        1, {},
+    },
+    {
+        "rotate an arrow to reach a zombie",
+        {
+            "       ",
+            "   v  1",
+            "   A   ",
+            "       ",
+            "2      ",
+        },
+        {100, 1}, {{20, 10, 1}, {50, 10, 1}},
+        0, {{1, 3, 3}},
+    },
+    {
+        "rotate two arrows to reach a zombie",
+        {
+            "  <  1 ",
+            "       ",
+            "  vA   ",
+            "       ",
+            "      2",
+        },
+        {100, 2}, {{30, 10, 1}, {50, 10, 1}},
+        2, {{2, 2, 0}, {0, 2, 3}},
+    }
+};
+
+// GameState of a regression board
+GameState makeFixedBoard(const HintRegression& regression)
+{
+    GameState state;
+    state.rows = regression.rows.size();
+    state.cols = regression.rows[0].size();
+    state.board.resize(state.rows, state.cols, ' ');
+    state.numberOfZombies = regression.zombies.size();
+    state.zombieAttributes.resize(state.numberOfZombies);
+    for(int row = 0; row < state.rows; row++)
+    {
+        for(int col = 0; col < state.cols; col++)
+        {
+            char cell = regression.rows[row][col];
+            state.board.set(row, col, cell);
+            if (cell == 'A')
+            {
+                // {row, col, health, attack, energy}
+                state.alienAttributes = {row, col, regression.alien[0], 0, regression.alien[1]};
+            }
+            else if (cell >= '1' && cell <= '9')
+            {
+                const vector<int>& zombie = regression.zombies[cell - '1'];
+                state.zombieAttributes[cell - '1'] = {cell - '0', row, col, zombie[0], zombie[1], zombie[2]};
+            }
+        }
+    }
+    state.numberOfPlayerTurns = 0;
+    state.healthLost = 0;
+    state.attackGained = 0;
+    state.randomSeed = 0;
+    state.randomPosition = 0;
+    return state;
+}
+
+// The lookup Game::checkCoordinate did before Board, kept here as the baseline
+int legacyCheckCoordinate(vector<vector<char>>& board, pair<int,int>& coord, int direction)
+{
+    vector<int> moveRow = {-1, 1, 0, 0, 0};
+    vector<int> moveColumn = {0, 0, -1, 1, 0};
+    int row = coord.first + moveRow[direction];
+    int column = coord.second + moveColumn[direction];
+
+    if (row < 0 || row >= (int)board.size() || column < 0 || column >= (int)board[0].size())
+    {
+        return -1;
+    }
+
+    switch(board[row][column])
+    {
+        case '^': return 0;
+        case 'v': return 1;
+        case '<': return 2;
+        case '>': return 3;
+        case 'h': return 4;
+        case 'p': return 5;
+        case 'r': return 6;
+        case ' ': return 7;
+        case 'A': return 8;
+        case '.': return 10;
+        default: return 9;
+    }
+}
+
+int boardCheckCoordinate(Board& board, pair<int,int>& coord, int direction)
+{
+    static const int moveRow[5] = {-1, 1, 0, 0, 0};
+    static const int moveColumn[5] = {0, 0, -1, 1, 0};
+    int row = coord.first + moveRow[direction];
+    int column = coord.second + moveColumn[direction];
+
+    if (!board.isInside(row, column))
+    {
+        return -1;
+    }
+    return board.cellAt(row, column);
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    int numOfBoards = argc > 1 ? atoi(argv[1]) : 50;
+    int lookups = argc > 2 ? atoi(argv[2]) : 20000000;
+
+    std::mt19937 rng(2023);
+    vector<GameState> states;
+    for(int i = 0; i < numOfBoards; i++)
+    {
+        states.push_back(makeBoard(9, 25, 9, rng));
+    }
+
+    // Lookups follow the access pattern of a slide: walk one way until the edge, then turn
+    Board& board = states[0].board;
+    vector<vector<char>> legacyBoard(board.getRows(), vector<char> (board.getCols()));
+    for(int i = 0; i < board.getRows(); i++)
+    {
+        for(int j = 0; j < board.getCols(); j++) legacyBoard[i][j] = board.get(i, j);
+    }
+
+    long long checksum = 0;
+    pair<int,int> coord = {4, 12};
+    int direction = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < lookups; i++)
+    {
+        int cell = legacyCheckCoordinate(legacyBoard, coord, direction);
+        checksum += cell;
+        if (cell == -1) direction = (direction + 1) & 3;
+        else if (direction < 2) coord.first += direction == 0 ? -1 : 1;
+        else coord.second += direction == 2 ? -1 : 1;
+    }
+    double legacySeconds = secondsSince(start);
+
+    coord = {4, 12};
+    direction = 0;
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < lookups; i++)
+    {
+        int cell = boardCheckCoordinate(board, coord, direction);
+        checksum -= cell;
+        if (cell == -1) direction = (direction + 1) & 3;
+        else if (direction < 2) coord.first += direction == 0 ? -1 : 1;
+        else coord.second += direction == 2 ? -1 : 1;
+    }
+    double boardSeconds = secondsSince(start);
+
+    cout << "lookups                : " << lookups << " (checksum " << checksum << ")\n";
+    cout << "vector<vector<char>>   : " << legacySeconds * 1e9 / lookups << " ns/lookup\n";
+    cout << "Board                  : " << boardSeconds * 1e9 / lookups << " ns/lookup\n";
+    cout << "lookup speedup         : " << legacySeconds / boardSeconds << "x\n";
+
+    // Set by every check that fails, the benchmark then exits with 1 once it has printed everything
+    bool failed = false;
+
+    Game game;
+
+    // Fixed boards have to keep giving the same hint
+    int regressionFailures = 0;
+    for(int i = 0; i < (int)hintRegressions.size(); i++)
+    {
+        GameState state = makeFixedBoard(hintRegressions[i]);
+        game.loadGame(state);
+        pair<int,vector<vector<int>>> hint = game.getHint();
+        if (hint.first == hintRegressions[i].direction && hint.second == hintRegressions[i].arrows) continue;
+
+        cout << "FAILED                 : " << hintRegressions[i].name << ", direction " << hint.first << " with arrows";
+        for(int j = 0; j < (int)hint.second.size(); j++)
+        {
+            cout << " {" << hint.second[j][0] << ", " << hint.second[j][1] << ", " << hint.second[j][2] << "}";
+        }
+        cout << "\n";
+        regressionFailures++;
+    }
+    cout << "hint regressions       : " << (int)hintRegressions.size() - regressionFailures << "/" << hintRegressions.size() << " fixed boards give the expected hint\n";
+    if (regressionFailures > 0) failed = true;
+
+    // Full hint search on every board
+    double hintSeconds = 0;
+    long long nodesVisited = 0, ttHits = 0;
+    // Hints are deterministic, the same boards must always give the same fingerprint
+    uint64_t fingerprint = 0;
+    for(int i = 0; i < numOfBoards; i++)
+    {
+        game.loadGame(states[i]);
+        start = std::chrono::steady_clock::now();
+        pair<int,vector<vector<int>>> hint = game.getHint();
+        hintSeconds += secondsSince(start);
+        checksum += hint.first + (int)hint.second.size();
+        fingerprint = Zobrist::mix(fingerprint ^ (hint.first + 1));
+        for(int j = 0; j < (int)hint.second.size(); j++)
+        {
+            fingerprint = Zobrist::mix(fingerprint ^ (hint.second[j][0] * 10000 + hint.second[j][1] * 10 + hint.second[j][2]));
+        }
+        nodesVisited += game.getHintStats().nodesVisited;
+        ttHits += game.getHintStats().ttHits;
+    }
+    cout << "hints                  : " << numOfBoards << " on 9x25 boards with 9 zombies\n";
+    cout << "hint search            : " << hintSeconds * 1e6 / numOfBoards << " us/hint\n";
+    cout << "nodes visited          : " << nodesVisited / numOfBoards << " per hint\n";
+    cout << "transposition hits     : " << ttHits / numOfBoards << " per hint\n";
+    cout << "hint fingerprint       : " << std::hex << fingerprint << std::dec << "\n";
+
+    // Asking again with nothing changed is answered from the hint cache
+    double repeatSeconds = 0;
+    for(int i = 0; i < numOfBoards; i++)
+    {
+        game.loadGame(states[i]);
+        game.getHint();
+        start = std::chrono::steady_clock::now();
+        game.getHint();
+        repeatSeconds += secondsSince(start);
+    }
+    cout << "repeated hint          : " << repeatSeconds * 1e6 / numOfBoards << " us/hint\n";
+
+    // Once a game has had one hint, later hints must not touch the heap
+    // Changing the alien's energy throws the hint cache away, so those hints search the whole tree again
+    HintResult result;
+    long long cachedAllocations = 0, searchAllocations = 0;
+    for(int i = 0; i < numOfBoards; i++)
+    {
+        game.loadGame(states[i]);
+        game.getHint(result);
+
+        long long before = allocations;
+        game.getHint(result);
+        cachedAllocations += allocations - before;
+
+        game.alien.decEnergy();
+        before = allocations;
+        game.getHint(result);
+        searchAllocations += allocations - before;
+        checksum += result.direction + result.arrows.size;
+    }
+    cout << "allocations per hint   : " << (double)searchAllocations / numOfBoards << " searching, " << (double)cachedAllocations / numOfBoards << " from the cache\n";
+    if (searchAllocations != 0 || cachedAllocations != 0)
+    {
+        cout << "FAILED                 : a hint after the first one allocated\n";
+        failed = true;
+    }
+
+    // Parallel hint on the same boards, it has to agree with the serial one
+    int numOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    double parallelSeconds = 0;
+    int mismatches = 0;
+    for(int i = 0; i < numOfBoards; i++)
+    {
+        game.loadGame(states[i]);
+        pair<int,vector<vector<int>>> hint = game.getHint();
+        start = std::chrono::steady_clock::now();
+        pair<int,vector<vector<int>>> parallelHint = game.getParallelHint(numOfThreads);
+        parallelSeconds += secondsSince(start);
+        mismatches += hint != parallelHint;
+    }
+    cout << "parallel hint search   : " << parallelSeconds * 1e6 / numOfBoards << " us/hint on " << numOfThreads << " threads\n";
+    cout << "parallel speedup       : " << hintSeconds / parallelSeconds << "x (" << mismatches << " hints differ)\n";
+
+    // Hint with a time budget, report how deep it got
+    int budget = 1;
+    int depthSum = 0, completed = 0;
+    double timedSeconds = 0, slowest = 0;
+    for(int i = 0; i < numOfBoards; i++)
+    {
+        game.loadGame(states[i]);
+        start = std::chrono::steady_clock::now();
+        TimedHint hint = game.getHintWithin(budget);
+        double seconds = secondsSince(start);
+        timedSeconds += seconds;
+        slowest = std::max(slowest, seconds);
+        depthSum += hint.depthReached;
+        completed += hint.complete;
+    }
+    cout << "timed hint (" << budget << " ms)      : " << timedSeconds * 1e6 / numOfBoards << " us/hint, slowest " << slowest * 1e6 << " us\n";
+    cout << "timed hint depth       : " << (double)depthSum / numOfBoards << " rotations on average, " << completed << "/" << numOfBoards << " finished\n";
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+#include "../game/game.h"
+#include "../display/display.h"
+#include "../display/screen.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+using std::cout;
+using std::vector;
+using std::string;
+
+// Benchmark for drawing the game screen, every step of every move is a frame the way Controller animates it
+// Frames are drawn on a Screen the size of a terminal that is never printed to, games come from fixed seeds
+
+// Every heap allocation the benchmark makes, to count the ones a frame makes
+static long long allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+struct RenderStats
+{
+    long long frames, frameBytes, sentBytes, allocations;
+    double seconds;
+};
+
+// Compose and render one frame of the game as it is now
+void drawFrame(Game& game, Screen& screen, string& frame, RenderStats& stats)
+{
+    long long allocationsBefore = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    frame.clear();
+    Display::composeGameState(frame, 0, 0, game.getView());
+    const string& sent = screen.render(frame, 0);
+
+    stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.allocations += allocations - allocationsBefore;
+    stats.frames++;
+    stats.frameBytes += frame.size();
+    stats.sentBytes += sent.size();
+}
+
+RenderStats benchmarkBoard(int rows, int cols, int numOfGames, int movesPerGame)
+{
+    RenderStats stats = {0, 0, 0, 0, 0};
+    Game game;
+    Screen screen(60, 200);
+    string frame;
+    vector<GameEvent> events;
+
+    for(int i = 0; i < numOfGames; i++)
+    {
+        game.newGame(rows, cols, 9, 2, 2023 + i);
+        drawFrame(game, screen, frame, stats);
+        for(int move = 0; move < movesPerGame && !game.gameOver; move++)
+        {
+            int currentTurn = game.getCurrentTurn();
+            if (currentTurn == 0)
+            {
+                game.beginAlienMove(move % 4);
+            }
+            else
+            {
+                game.beginZombieMove(currentTurn, game.getRandomZombieDirection(currentTurn));
+            }
+
+            bool isMoving = true;
+            while (isMoving)
+            {
+                events.clear();
+                isMoving = game.stepMove(events);
+                drawFrame(game, screen, frame, stats);
+            }
+            game.nextTurn();
+        }
+    }
+    return stats;
+}
+
+int main(int argc, char* argv[])
+{
+    int numOfGames = argc > 1 ? atoi(argv[1]) : 200;
+    int movesPerGame = argc > 2 ? atoi(argv[2]) : 50;
+
+    vector<pair<int,int>> boardSizes = {{3, 9}, {5, 13}, {7, 19}, {9, 25}};
+    for(int i = 0; i < (int)boardSizes.size(); i++)
+    {
+        int rows = boardSizes[i].first, cols = boardSizes[i].second;
+        RenderStats stats = benchmarkBoard(rows, cols, numOfGames, movesPerGame);
+
+        cout << rows << "x" << cols << " board" << string(cols < 10 ? 14 : 13, ' ') << ": "
+             << stats.frames / stats.seconds << " frames/sec, "
+             << (double)stats.sentBytes / stats.frames << " bytes sent per frame ("
+             << (double)stats.frameBytes / stats.frames << " in a full frame), "
+             << (double)stats.allocations / stats.frames << " allocations per frame\n";
+    }
+
+    return 0;
+}
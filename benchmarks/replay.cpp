@@ -0,0 +1,36 @@
+#include "../game/replay.h"
+#include <iostream>
+#include <chrono>
+
+using std::cout;
+
+// Play replays again without the display, as fast as the game runs, and check each one ends the way it was recorded
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cout << "usage: replay [replay file]...\n";
+        return 1;
+    }
+
+    int numOfFailed = 0;
+    long long totalCommands = 0, totalEvents = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 1; i < argc; i++)
+    {
+        ReplayResult result = Replays::playReplay(argv[i]);
+        totalCommands += result.commands;
+        totalEvents += result.events;
+        if (!result.matches)
+        {
+            numOfFailed++;
+            cout << argv[i] << ": " << result.error << " after " << result.commands << " commands\n";
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    cout << "replays                : " << argc - 1 << ", " << argc - 1 - numOfFailed << " matched, " << numOfFailed << " failed\n";
+    cout << "commands               : " << totalCommands << " (" << totalEvents << " events), " << totalCommands / seconds << " per second\n";
+
+    return numOfFailed ? 1 : 0;
+}
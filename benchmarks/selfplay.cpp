@@ -0,0 +1,175 @@
+#include "../game/game.h"
+#include "../game/replay.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#include <string>
+
+using std::cout;
+using std::vector;
+
+// Headless self-play, the alien follows the hint and the zombies move the way Controller moves them
+// Game i is generated from seed firstSeed + i, so a run can be repeated exactly, on any number of threads
+
+// Games that go on this long are stopped and counted as unfinished
+const int maxAlienTurns = 500;
+
+// One per thread, aligned so two threads never write to the same cache line
+struct alignas(64) SelfPlayStats
+{
+    int wins, losses, unfinished;
+    long long turns;
+    // Seconds taken by every hint, in the order they were asked
+    vector<double> hintSeconds;
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Play one game to the end, same turn order and energy rules as Controller::startGame
+// Every command is also given to recorder, unless it is null
+void playGame(Game& game, SelfPlayStats& stats, ReplayRecorder* recorder)
+{
+    HintResult hint;
+    vector<GameEvent> events;
+    bool alienHasMoved = false;
+    int alienTurns = 0;
+
+    while (!game.gameOver && alienTurns < maxAlienTurns)
+    {
+        int currentTurn = game.getCurrentTurn();
+        events.clear();
+        if (currentTurn == 0)
+        {
+            if (alienHasMoved)
+            {
+                game.alien.incEnergy();
+                if (recorder) recorder->energyGained();
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            game.getHint(hint);
+            stats.hintSeconds.push_back(secondsSince(start));
+
+            for(int i = 0; i < hint.arrows.size; i++)
+            {
+                pair<int,int> arrowCoordinates = {hint.arrows.changes[i].row, hint.arrows.changes[i].col};
+                game.changeArrowDirection(arrowCoordinates, hint.arrows.changes[i].direction);
+                game.alien.decEnergy();
+                if (recorder) recorder->arrowChange(arrowCoordinates, hint.arrows.changes[i].direction);
+            }
+            if (hint.direction != -1)
+            {
+                game.applyAlienMove(hint.direction, events);
+                if (recorder) recorder->alienMove(hint.direction, events);
+            }
+            alienHasMoved = true;
+            alienTurns++;
+        }
+        else
+        {
+            int direction = game.getRandomZombieDirection(currentTurn);
+            game.applyZombieMove(currentTurn, direction, events);
+            if (recorder) recorder->zombieMove(currentTurn, direction, events);
+        }
+        game.nextTurn();
+        if (recorder) recorder->nextTurn();
+        stats.turns++;
+    }
+
+    if (!game.gameOver) stats.unfinished++;
+    else if (game.alien.isAlive()) stats.wins++;
+    else stats.losses++;
+}
+
+// Hint time at fraction of the sorted latencies
+double percentile(vector<double>& sorted, double fraction)
+{
+    if (sorted.empty()) return 0;
+    int index = std::min((int)sorted.size() - 1, (int)(fraction * sorted.size()));
+    return sorted[index];
+}
+
+int main(int argc, char* argv[])
+{
+    int numOfGames = argc > 1 ? atoi(argv[1]) : 200;
+    int rows = argc > 2 ? atoi(argv[2]) : 5;
+    int cols = argc > 3 ? atoi(argv[3]) : 9;
+    int numOfZombies = argc > 4 ? atoi(argv[4]) : 1;
+    int difficulty = argc > 5 ? atoi(argv[5]) : 1;
+    unsigned int firstSeed = argc > 6 ? atoi(argv[6]) : 2023;
+
+    int numOfThreads = argc > 7 ? atoi(argv[7]) : 1;
+    if (numOfThreads <= 0) numOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    // Game with seed s is recorded to replayDirectory/s.replay, nothing is recorded without one
+    std::string replayDirectory = argc > 8 ? argv[8] : "";
+
+    // Each thread plays with its own Game and takes the next seed until none are left
+    // Threads only share the seed counter, their stats are merged once they have all finished
+    vector<SelfPlayStats> threadStats(numOfThreads);
+    std::atomic<int> nextGame(0);
+    auto start = std::chrono::steady_clock::now();
+    vector<std::thread> threads;
+    for(int t = 0; t < numOfThreads; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            Game game;
+            ReplayRecorder recorder;
+            ReplayRecorder* gameRecorder = replayDirectory.empty() ? nullptr : &recorder;
+            SelfPlayStats& stats = threadStats[t];
+            stats.wins = stats.losses = stats.unfinished = 0;
+            stats.turns = 0;
+            for(int i = nextGame.fetch_add(1); i < numOfGames; i = nextGame.fetch_add(1))
+            {
+                game.newGame(rows, cols, numOfZombies, difficulty, firstSeed + i);
+                if (gameRecorder) gameRecorder->start(game);
+                playGame(game, stats, gameRecorder);
+                if (gameRecorder)
+                {
+                    gameRecorder->finish(game);
+                    gameRecorder->save(replayDirectory + "/" + std::to_string(firstSeed + i) + ".replay");
+                }
+            }
+        });
+    }
+    for(int t = 0; t < numOfThreads; t++) threads[t].join();
+    double seconds = secondsSince(start);
+
+    SelfPlayStats stats;
+    stats.wins = stats.losses = stats.unfinished = 0;
+    stats.turns = 0;
+    for(int t = 0; t < numOfThreads; t++)
+    {
+        stats.wins += threadStats[t].wins;
+        stats.losses += threadStats[t].losses;
+        stats.unfinished += threadStats[t].unfinished;
+        stats.turns += threadStats[t].turns;
+        stats.hintSeconds.insert(stats.hintSeconds.end(), threadStats[t].hintSeconds.begin(), threadStats[t].hintSeconds.end());
+    }
+
+    vector<double> sorted = stats.hintSeconds;
+    std::sort(sorted.begin(), sorted.end());
+    double hintTotal = 0;
+    for(int i = 0; i < (int)sorted.size(); i++) hintTotal += sorted[i];
+
+    cout << "games                  : " << numOfGames << " on " << rows << "x" << cols << " boards with " << numOfZombies << " zombies, difficulty " << difficulty << ", " << numOfThreads << " threads\n";
+    cout << "games/sec              : " << numOfGames / seconds << "\n";
+    cout << "turns/sec              : " << stats.turns / seconds << " (" << (double)stats.turns / numOfGames << " turns per game)\n";
+    cout << "hints                  : " << sorted.size() << ", " << hintTotal / seconds / numOfThreads * 100 << "% of the time\n";
+    cout << "hint latency (us)      : mean " << (sorted.empty() ? 0 : hintTotal / sorted.size() * 1e6)
+         << ", p50 " << percentile(sorted, 0.5) * 1e6
+         << ", p90 " << percentile(sorted, 0.9) * 1e6
+         << ", p99 " << percentile(sorted, 0.99) * 1e6
+         << ", max " << (sorted.empty() ? 0 : sorted.back() * 1e6) << "\n";
+    cout << "win rate               : " << 100.0 * stats.wins / numOfGames << "% (" << stats.wins << " won, " << stats.losses << " lost, " << stats.unfinished << " unfinished after " << maxAlienTurns << " alien turns)\n";
+
+    return 0;
+}
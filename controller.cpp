@@ -5,22 +5,26 @@
 #include "game/game_state.h"
 #include "save/save.h"
 
-Controller::Controller()
+template<class Renderer>
+Controller<Renderer>::Controller(Renderer renderer) : renderer(std::move(renderer))
 {
     // set default theme
     this->borderThemeID = 0;
     this->objectThemeID = 0;
+
+    // Keep the last 100 turns for undo
+    game.setUndoLimit(100);
 }
 
 // Create a new game
-void Controller::newGame()
+template<class Renderer>
+void Controller<Renderer>::newGame()
 {
     pair<int, int> boardDimensions;
     int difficulty, numOfZombies;
 
     // Default values
     this->saveNumberChoice = 0;
-    this->numberOfPlayerTurns = 0;
     this->alienHasMoved = false;
 
     // Get the input from user
@@ -53,7 +57,8 @@ void Controller::newGame()
 }
 
 // Load game from save file
-void Controller::loadGame()
+template<class Renderer>
+void Controller<Renderer>::loadGame()
 { 
     // Get list of save files
     vector<int> saveFiles;
@@ -86,7 +91,6 @@ void Controller::loadGame()
     this->numOfCols = state.cols;
 
     // Load values from save file
-    this->numberOfPlayerTurns = state.numberOfPlayerTurns;
     this->alienHasMoved = false;
 
     // Load and start game from GameState
@@ -95,10 +99,14 @@ void Controller::loadGame()
 }
 
 // Start the game. Most of the logic for the game itself is contained within this function
-void Controller::startGame()
+template<class Renderer>
+void Controller<Renderer>::startGame()
 {
     bool quit = false;
     bool displayHint = false;
+    bool displayHintStats = false;
+    bool displayLookaheadHint = false;
+    this->recorder.start(game);
     while (!game.gameOver && !quit)
     {
         int currentTurn = game.getCurrentTurn();
@@ -107,18 +115,45 @@ void Controller::startGame()
         if (this->alienHasMoved == true && currentTurn == 0)
         {
             game.alien.incEnergy();
+            this->recorder.energyGained();
             this->alienHasMoved = false;
+
+            // Undo comes back to the start of the alien's turn
+            game.checkpoint();
+            this->recorder.checkpoint();
         }
         
-        Display::displayGameState(borderThemeID, objectThemeID, game.getGameState(), game.getCurrentTurn());
+        this->renderer.drawGame(game, borderThemeID, objectThemeID);
 
         // Display hint once between Game State and Input for command if user has asked for hint
         if (displayHint)
         {
-            Display::displayHint(this->numOfRows, game.getHint());
+            // Never keep the player waiting more than 2 seconds for a hint
+            // Boards in the game are small, one thread with the hint cache beats waking up the pool
+            TimedHint hint = game.getHintWithin(2000, 1);
+            Display::displayHint(this->numOfRows, {hint.direction, hint.arrows.toVectors()});
+            Display::displayHintDepth(hint.depthReached, hint.complete);
             displayHint = false;
         }
 
+        // Display the hint that weighs the zombies' next moves
+        if (displayLookaheadHint)
+        {
+            // Three rounds ahead, the node budget keeps it well under a second on a full board
+            LookaheadHint hint = game.getLookaheadHint(3, 1000000);
+            Display::displayHint(this->numOfRows, {hint.direction, hint.arrows.toVectors()});
+            Display::displayHintRounds(hint.roundsReached, 3);
+            displayLookaheadHint = false;
+        }
+
+        // Display how much work the last hint took
+        if (displayHintStats)
+        {
+            HintStats stats = game.getHintStats();
+            Display::displayHintStats({stats.nodesVisited, stats.ttHits, stats.ttStores, stats.cacheHits});
+            displayHintStats = false;
+        }
+
         // current turn = 0 means its alien (i.e user) turn
 		if (currentTurn == 0)
         {
@@ -151,10 +186,10 @@ void Controller::startGame()
                         continue;
                     }
 
-                    this->numberOfPlayerTurns++;
                     this->keepMovingAlien(command-1);
                     this->alienHasMoved = true;
                     game.nextTurn();
+                    this->recorder.nextTurn();
                 }
                 // Change certain arrow direction
                 else if (command == 5)
@@ -166,9 +201,9 @@ void Controller::startGame()
                     // if coordinates is valid
                     if (command == -1)
                     {
-                        Display::displayGameState(borderThemeID, objectThemeID, game.getGameState(), game.getCurrentTurn());
+                        this->renderer.drawGame(game, borderThemeID, objectThemeID);
                         Display::displayErrorMessage();
-                        Display::displayGameState(borderThemeID, objectThemeID, game.getGameState(), game.getCurrentTurn());
+                        this->renderer.drawGame(game, borderThemeID, objectThemeID);
                         continue;
                     }
 
@@ -176,7 +211,7 @@ void Controller::startGame()
                     if (game.alien.getEnergy() == 0)
                     {
                         // will change to no energy message
-                        Display::displayGameState(borderThemeID, objectThemeID, game.getGameState(), game.getCurrentTurn());
+                        this->renderer.drawGame(game, borderThemeID, objectThemeID);
                         Display::displayNoEnergy();
                         continue;
                     }
@@ -187,7 +222,7 @@ void Controller::startGame()
                     {
                         game.changeArrowDirection(arrowCoordinates, newDirection-1);
                         game.alien.decEnergy();
-                        
+                        this->recorder.arrowChange(arrowCoordinates, newDirection-1);
                     }
                 }
                 // Save game
@@ -207,7 +242,6 @@ void Controller::startGame()
                     }
                     this->saveNumberChoice = saveNum;
                     GameState state = game.getGameState();
-                    state.numberOfPlayerTurns = this->numberOfPlayerTurns;
                     Saves::gameStateToSaveFile(saveNum, state);
                 }
                 // Quit game
@@ -221,41 +255,67 @@ void Controller::startGame()
                 {
                     displayHint = true;
                 }
+                // Display hint stats
+                else if (command == 9)
+                {
+                    displayHintStats = true;
+                }
+                // Display lookahead hint
+                else if (command == 10)
+                {
+                    displayLookaheadHint = true;
+                }
+                // Change how fast the pieces move
+                else if (command == 13)
+                {
+                    int speed = Display::getAnimationSpeed(this->renderer.getSpeed());
+                    while (speed == -1)
+                    {
+                        Display::displayErrorMessage();
+                        speed = Display::getAnimationSpeed(this->renderer.getSpeed());
+                    }
+                    this->renderer.setSpeed(speed);
+                }
+                // Undo or redo a turn
+                else if (command == 11 || command == 12)
+                {
+                    bool done = (command == 11) ? game.undo() : game.redo();
+                    if (!done)
+                    {
+                        Display::displayNothingToUndo(command == 11 ? 'u' : 'r');
+                    }
+                    else if (command == 11)
+                    {
+                        this->recorder.undo();
+                    }
+                    else
+                    {
+                        this->recorder.redo();
+                    }
+                }
             }
         } 
         else 
         {
             // Zombie's turn, randomly move zombie in a valid direction
-            int newDirection = rand() % 4;
-            pair<int,int> currentCoordinate = game.zombies[currentTurn-1].getCoordinates();
-            int coordinatesCode = game.checkCoordinate(currentCoordinate, newDirection);
-            while (coordinatesCode == -1 || coordinatesCode == 8 || coordinatesCode == 9)
-            {
-                newDirection = rand() % 4;
-                coordinatesCode = game.checkCoordinate(currentCoordinate, newDirection);
-            }
-            this->keepMovingZombie(currentTurn, newDirection);
+            this->keepMovingZombie(currentTurn, game.getRandomZombieDirection(currentTurn));
             game.nextTurn();
+            this->recorder.nextTurn();
         }
     }
+
+    // Keep the last game played, quit or not, for Replays::playReplay
+    this->recorder.finish(game);
+    this->recorder.save("save/replays/last.replay");
     
     // When game ends
     if (game.gameOver)
     {
-        // alien win
-        if (game.alien.isAlive())
-        {
-            Display::displayWinLose(true, 100);
-        }
-        // alien lose
-        else
-        {
-            Display::displayWinLose(false, 100);
-        }
+        // alien win or lose
+        this->renderer.drawWinLose(game.alien.isAlive());
 
         // Adjust player stats once the game ends
         GameState finalState = game.getGameState();
-        finalState.numberOfPlayerTurns = this->numberOfPlayerTurns;
         
         Saves::addToPlayerStats(
             finalState,
@@ -289,155 +349,120 @@ void Controller::startGame()
     {3, x, y} = zombie x dealth y damage to alien
 */
 // Displays when something specific happens (eg. encounter pod, zombie attack etc)
-void Controller::displayWithAction(vector<int> a)
+template<class Renderer>
+void Controller<Renderer>::displayWithAction(vector<int> a)
 {
-    Display::displayGameState(borderThemeID, objectThemeID, game.getGameState(), game.getCurrentTurn());
-    Display::displayGameAction(a);
+    this->renderer.drawAction(game, borderThemeID, objectThemeID, a);
 }
 
 // Displays when normal things happen (eg. alien moving on an empty cell)
-void Controller::displayWithoutAction(int millisecond)
+// millisecond is how long the step shows at normal speed
+template<class Renderer>
+void Controller<Renderer>::displayWithoutAction(int millisecond)
 {
-    Display::displayGameState(borderThemeID, objectThemeID, game.getGameState(), game.getCurrentTurn());
-    Display::pauseForMilliseconds(millisecond);
+    this->renderer.drawStep(game, borderThemeID, objectThemeID, millisecond);
 }
 
-
-void Controller::keepMovingAlien(int direction)
+// Show what a step of a move did
+template<class Renderer>
+void Controller<Renderer>::animate(vector<GameEvent>& events)
 {
-    vector<pair<int,int>> trails;
-    bool isMoving = true;	
-    int currentDirection = direction;
+    // Nothing would be shown, don't even build the messages
+    if constexpr (!Renderer::drawsFrames) return;
 
-    while (isMoving)
+    for (int i = 0; i < (int)events.size(); i++)
     {
-        /*
-            invalid = -1
-            arrows = 0-3
-            health = 4
-            pod = 5
-            rock = 6
-            empty space = 7
-            alien = 8
-            zombie = 9
-        */
-        
-        pair<int,int> currentCoordinates = game.alien.getCoordinates();
-        int result = game.checkCoordinate(currentCoordinates,currentDirection);
-        if (result >= 0 && result <= 3)
-        {
-            game.encounterArrow();
-            trails.push_back(currentCoordinates);
-            game.moveAlien(currentDirection);
-            currentDirection = result;
-            this->displayWithoutAction(1000);
-        }
-        else if (result == 4)
-        {
-            game.encounterHealth();
-            trails.push_back(currentCoordinates);
-            game.moveAlien(currentDirection);
-            this->displayWithAction({0});
-        }
-        else if (result == 5)
+        GameEvent& event = events[i];
+        switch (event.type)
         {
-            int zombieAttacked = game.encounterPod();
-            trails.push_back(currentCoordinates);
-            game.moveAlien(currentDirection);
-            this->displayWithAction({2,zombieAttacked});
-            if (game.gameOver) break;
-        }
-        else if (result == 6)
-        {
-            isMoving = false;
-            vector<int> moveRow = {-1, 1, 0, 0};
-            vector<int> moveCol = {0, 0, -1, 1};
-            pair<int,int> rockCoordinates = currentCoordinates;
-            rockCoordinates.first += moveRow[currentDirection];
-            rockCoordinates.second += moveCol[currentDirection];
-            game.encounterRock(rockCoordinates);
-            this->displayWithAction({1, 0});
-        }
-        else if (result == 7 || result == 10)
-        {
-            game.moveAlien(currentDirection);
-            trails.push_back(currentCoordinates);
-            this->displayWithoutAction(1000);
-        }
-        else if (result == 9)
-        {
-            vector<int> moveRow = {-1, 1, 0, 0};
-            vector<int> moveCol = {0, 0, -1, 1};
-            pair<int,int> zombieCoordinates = currentCoordinates;
-            zombieCoordinates.first += moveRow[currentDirection];
-            zombieCoordinates.second += moveCol[currentDirection];
-
-            this->displayWithAction({3, game.getZombieIDAt(zombieCoordinates)});
-            if (game.attackZombie(zombieCoordinates))
-            {
-                int zombieID = game.getZombieIDAt(zombieCoordinates);
-                trails.push_back(currentCoordinates);
-                game.moveAlien(currentDirection);
-                this->displayWithAction({5, zombieID});
-                if (game.gameOver) break;
-            }
-            else
-            {
-                isMoving = false;
-            }
-        }
-        else 
-        {
-            isMoving = false;
-            this->displayWithAction({6});
+            case ALIEN_MOVED:
+            case ALIEN_ARROW:
+                this->displayWithoutAction(1000);
+                break;
+            case ALIEN_HEALTH:
+                this->displayWithAction({0});
+                break;
+            case ALIEN_POD:
+                this->displayWithAction({2, event.zombieID});
+                break;
+            case ALIEN_ROCK:
+                this->displayWithAction({1, 0});
+                break;
+            case ALIEN_ZOMBIE_AHEAD:
+                this->displayWithAction({3, event.zombieID});
+                break;
+            case ALIEN_ZOMBIE_KILLED:
+                this->displayWithAction({5, event.zombieID});
+                break;
+            case ALIEN_WALL:
+                this->displayWithAction({6});
+                break;
+            case TRAIL_REGENERATED:
+                this->displayWithoutAction(500);
+                break;
+            case ZOMBIE_ROCK:
+                this->displayWithAction({1, 1, event.zombieID});
+                break;
+            case ZOMBIE_ATTACK:
+                if (event.amount > 0)
+                {
+                    this->displayWithAction({7, event.zombieID, 1});
+                    this->displayWithAction({4, event.zombieID, event.amount});
+                }
+                else
+                {
+                    this->displayWithAction({7, event.zombieID, 0});
+                }
+                break;
+            // Shown by the next step
+            case ALIEN_ZOMBIE_SURVIVED:
+            case ZOMBIE_MOVED:
+            case ZOMBIE_PASSED:
+                break;
         }
     }
-    vector<vector<bool>> hasGenerated(this->numOfRows, vector<bool>(this->numOfCols));
-    for(int i = 0; i < trails.size(); i++)
-    {
-        if (trails[i] == game.alien.getCoordinates() || hasGenerated[trails[i].first][trails[i].second]) continue;
-        hasGenerated[trails[i].first][trails[i].second] = 1;
-        game.clearTrail(trails[i]);
-        displayWithoutAction(500);
-    }
-    game.alien.incAttack(-game.alien.getAttack());
 }
 
-void Controller::keepMovingZombie(int id, int direction)
+// Play the alien's move one step at a time, showing each step
+template<class Renderer>
+void Controller<Renderer>::keepMovingAlien(int direction)
 {
+    vector<GameEvent> events, moveEvents;
+    bool isMoving = true;
 
-    pair<int,int> currentCoordinates = game.zombies[id-1].getCoordinates();
-    int result = game.checkCoordinate(currentCoordinates, direction);
-
-    //if zombie steps on a rock
-    if (result == 6)
-    {
-        vector<int> moveRow = {-1, 1, 0, 0};
-        vector<int> moveCol = {0, 0, -1, 1};
-        pair<int,int> rockCoordinates = currentCoordinates;
-        rockCoordinates.first += moveRow[direction];
-        rockCoordinates.second += moveCol[direction];
-        displayWithAction({1, 1, id});
-        game.encounterRock(rockCoordinates);
-    }
-    else
+    // Pressing Enter from here on skips to the player's next turn, past the zombies' moves too
+    this->renderer.startTurn();
+    game.beginAlienMove(direction);
+    while (isMoving)
     {
-        game.moveZombie(id, direction);
+        events.clear();
+        isMoving = game.stepMove(events);
+        this->animate(events);
+        moveEvents.insert(moveEvents.end(), events.begin(), events.end());
     }
+    this->recorder.alienMove(direction, moveEvents);
+}
 
-    if (game.attackAlien(id))
-    {
-        displayWithAction({7, id, 1});
-        displayWithAction({4, id, game.zombies[id-1].getAttack()});
-    }
-    else
+// Play zombie id's move one step at a time, showing each step
+template<class Renderer>
+void Controller<Renderer>::keepMovingZombie(int id, int direction)
+{
+    vector<GameEvent> events, moveEvents;
+    bool isMoving = true;
+    game.beginZombieMove(id, direction);
+    while (isMoving)
     {
-        displayWithAction({7, id, 0});
+        events.clear();
+        isMoving = game.stepMove(events);
+        this->animate(events);
+        moveEvents.insert(moveEvents.end(), events.begin(), events.end());
     }
+    this->recorder.zombieMove(id, direction, moveEvents);
 }
 
 // Sets the object theme based off user selection
-void Controller::changeObjectThemeMenu()
+template<class Renderer>
+void Controller<Renderer>::changeObjectThemeMenu()
 {
     bool quit = false;
     while (!quit)
@@ -461,7 +486,8 @@ void Controller::changeObjectThemeMenu()
 }
 
 // Sets the border theme based off user selection
-void Controller::changeBorderThemeMenu()
+template<class Renderer>
+void Controller<Renderer>::changeBorderThemeMenu()
 {
     bool quit = false;
     while (!quit)
@@ -485,7 +511,8 @@ void Controller::changeBorderThemeMenu()
 }
 
 // Display Theme menu
-void Controller::themeMenu()
+template<class Renderer>
+void Controller<Renderer>::themeMenu()
 {
     bool quit = false;
     while (!quit)
@@ -513,7 +540,8 @@ void Controller::themeMenu()
 }
 
 // Displays main menu
-void Controller::mainMenu()
+template<class Renderer>
+void Controller<Renderer>::mainMenu()
 {
     bool quit = false;
     while (!quit)
@@ -544,3 +572,7 @@ void Controller::mainMenu()
         }
     }
 }
+
+template class Controller<TerminalRenderer>;
+template class Controller<NullRenderer>;
+template class Controller<RecordingRenderer>;
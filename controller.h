@@ -2,7 +2,11 @@
 #define CONTROLLER_H
 
 #include "game/game.h"
+#include "game/replay.h"
+#include "display/renderer.h"
 
+// Runs the menus and the game, Renderer (see renderer.h) shows the game's frames
+template<class Renderer>
 class Controller
 {
     private:
@@ -11,9 +15,10 @@ class Controller
         int maxHealth, minHealth, maxDamage, minDamage, minZombieRange, maxZombieRange;
         int numOfRows, numOfCols;
         int saveNumberChoice;
-        int numberOfPlayerTurns;
         bool alienHasMoved;
         Game game;
+        ReplayRecorder recorder;
+        Renderer renderer;
 
         void themeMenu();
         void changeObjectThemeMenu();
@@ -23,13 +28,14 @@ class Controller
         void startGame();
         void keepMovingAlien(int direction);
         void keepMovingZombie(int id, int direction);
+        void animate(vector<GameEvent>& events);
         void displayWithAction(vector<int> action);
         void displayWithoutAction(int millisecond);
 
 
     public:
 
-        Controller();
+        Controller(Renderer renderer = Renderer());
         void mainMenu();
 };
 
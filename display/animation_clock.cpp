@@ -0,0 +1,113 @@
+#include <chrono>
+#include <thread>
+#include "animation_clock.h"
+
+#if defined(_WIN32)
+    #include <conio.h>
+    #include <io.h>
+    #include <cstdio>
+#elif defined(__linux__) || defined(__APPLE__)
+    #include <sys/select.h>
+    #include <unistd.h>
+#endif
+
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+AnimationClock::AnimationClock()
+{
+    this->speed = 1;
+    this->skipping = false;
+    this->deadline = steady_clock::now();
+}
+
+// How many times faster than normal animations play, 0 skips them
+void AnimationClock::setSpeed(int speed)
+{
+    this->speed = speed;
+}
+
+int AnimationClock::getSpeed()
+{
+    return this->speed;
+}
+
+// Call before a turn's animation starts, the first frame is timed from now and the turn isn't skipped yet
+void AnimationClock::startTurn()
+{
+    this->skipping = false;
+    this->deadline = steady_clock::now();
+}
+
+// True once the player has asked to skip the turn, the caller draws nothing until it is over
+bool AnimationClock::isSkipping()
+{
+    if (this->speed == 0) return true;
+    if (!this->skipping && this->keyPressed(0)) this->skipping = true;
+    return this->skipping;
+}
+
+// Wait until the frame just drawn has been shown for timeInMilliseconds (at normal speed)
+void AnimationClock::wait(int timeInMilliseconds)
+{
+    if (this->isSkipping()) return;
+
+    steady_clock::time_point now = steady_clock::now();
+    milliseconds frameTime(timeInMilliseconds / this->speed);
+
+    // Don't hurry through the next frames to catch up after a slow one (or the player reading a message)
+    if (this->deadline + frameTime < now) this->deadline = now;
+    this->deadline += frameTime;
+
+    while (now < this->deadline)
+    {
+        int timeLeft = std::chrono::ceil<milliseconds>(this->deadline - now).count();
+        if (this->keyPressed(timeLeft))
+        {
+            this->skipping = true;
+            return;
+        }
+        now = steady_clock::now();
+    }
+}
+
+// Wait up to timeoutInMilliseconds for the player to press Enter (any key on Windows), and take the key press
+// Input that isn't typed in a terminal is never taken, it holds the next commands
+bool AnimationClock::keyPressed(int timeoutInMilliseconds)
+{
+    #if defined(_WIN32)
+        if (!_isatty(_fileno(stdin)))
+        {
+            std::this_thread::sleep_for(milliseconds(timeoutInMilliseconds));
+            return false;
+        }
+        steady_clock::time_point end = steady_clock::now() + milliseconds(timeoutInMilliseconds);
+        while (!_kbhit())
+        {
+            if (steady_clock::now() >= end) return false;
+            std::this_thread::sleep_for(milliseconds(10));
+        }
+        _getch();
+        return true;
+    #elif defined(__linux__) || defined(__APPLE__)
+        if (!isatty(STDIN_FILENO))
+        {
+            std::this_thread::sleep_for(milliseconds(timeoutInMilliseconds));
+            return false;
+        }
+        fd_set input;
+        FD_ZERO(&input);
+        FD_SET(STDIN_FILENO, &input);
+        timeval timeout;
+        timeout.tv_sec = timeoutInMilliseconds / 1000;
+        timeout.tv_usec = (timeoutInMilliseconds % 1000) * 1000;
+        if (select(STDIN_FILENO + 1, &input, nullptr, nullptr, &timeout) <= 0) return false;
+
+        // The terminal hands over a whole line at once, take all of it
+        char line[256];
+        return read(STDIN_FILENO, line, sizeof(line)) > 0;
+    #else
+        std::this_thread::sleep_for(milliseconds(timeoutInMilliseconds));
+        return false;
+    #endif
+}
@@ -0,0 +1,32 @@
+#ifndef ANIMATION_CLOCK_H
+#define ANIMATION_CLOCK_H
+
+#include <chrono>
+
+/*
+    Paces the frames of an animation
+
+    Every frame is due a set time after the one before it, divided by the speed, so the time spent
+    drawing a frame comes out of its wait instead of adding to it. Waiting watches the keyboard:
+    pressing Enter skips the rest of the animation, until startTurn is called again.
+    At speed 0 (instant) every animation is skipped from the start.
+*/
+class AnimationClock
+{
+    private:
+        int speed;
+        bool skipping;
+        std::chrono::steady_clock::time_point deadline;
+
+        bool keyPressed(int timeoutInMilliseconds);
+
+    public:
+        AnimationClock();
+        void setSpeed(int speed);
+        int getSpeed();
+        void startTurn();
+        bool isSkipping();
+        void wait(int timeInMilliseconds);
+};
+
+#endif
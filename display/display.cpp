@@ -4,7 +4,10 @@
 #include <utility>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <cstdio>
 #include "display.h"
+#include "screen.h"
 #include "themes/theme.h"
 
 using std::cout;
@@ -12,6 +15,9 @@ using std::cin;
 using std::vector;
 using std::string;
 
+// The terminal, remembers the last frame so the next one only sends what changed
+static Screen screen;
+
 
 // input validation functions
 bool Display::isInteger(string text)
@@ -76,8 +82,9 @@ void Display::clearScreen()
 {
     #if defined(_WIN32)
         std::system("cls");
-    #elif defined(__linux__) || defined(__APPLE__)
-        std::system("clear");
+        screen.invalidate();
+    #else
+        screen.clear();
     #endif
 }
 
@@ -322,6 +329,11 @@ int Display::getNumberOfZombies()
 // 6: save
 // 7: quit
 // 8: hint
+// 9: hint-stats
+// 10: hint-ahead
+// 11: undo
+// 12: redo
+// 13: speed
 int Display::getCommand()
 {
     string input;
@@ -337,6 +349,11 @@ int Display::getCommand()
     if (input.compare("save") == 0) return 6;
     if (input.compare("quit") == 0) return 7;
     if (input.compare("hint") == 0) return 8;
+    if (input.compare("hint-stats") == 0) return 9;
+    if (input.compare("hint-ahead") == 0) return 10;
+    if (input.compare("undo") == 0) return 11;
+    if (input.compare("redo") == 0) return 12;
+    if (input.compare("speed") == 0) return 13;
 
     return -1;
 }
@@ -363,7 +380,19 @@ void Display::displayHelp()
     cout << "|   7. quit (quit the game)          |" << "\n";
     cout << "+------------------------------------+" << "\n";
     cout << "|   8. hint (get a useful hint)      |" << "\n";
+    cout << "+------------------------------------+" << "\n";
+    cout << "|   9. hint-stats (last hint's work) |" << "\n";
+    cout << "+------------------------------------+" << "\n";
+    cout << "|  10. hint-ahead (hint that expects |" << "\n";
+    cout << "|      the zombies' next moves)      |" << "\n";
+    cout << "+------------------------------------+" << "\n";
+    cout << "|  11. undo (take back a turn)       |" << "\n";
+    cout << "+------------------------------------+" << "\n";
+    cout << "|  12. redo (play it again)          |" << "\n";
+    cout << "+------------------------------------+" << "\n";
+    cout << "|  13. speed (how fast pieces move)  |" << "\n";
     cout << "+====================================+" << "\n\n";
+    cout << "Press Enter while the pieces are moving to skip to your next turn.\n";
 
     pressEnterToContinue();
 }
@@ -418,6 +447,16 @@ void Display::displayNoEnergy()
     pressEnterToContinue();
 }
 
+// displays message when there is no turn to undo ('u') or redo ('r')
+void Display::displayNothingToUndo(char undoOrRedo)
+{
+    if (undoOrRedo == 'u')
+        cout << "There is no turn to undo!\n";
+    else
+        cout << "There is no turn to redo!\n";
+    pressEnterToContinue();
+}
+
 
 // get choice of user on where to save game
 // -1: invalid
@@ -608,139 +647,218 @@ int Display::getNewArrowDirection()
     return -1;
 }
 
+// -1: invalid
+// 1, 2, 4: times faster than normal
+// 0: instant
+int Display::getAnimationSpeed(int currentSpeed)
+{
+    clearScreen();
+    string input;
+    cout << "    .: Animation speed :.    \n";
+    cout << "+===========================+\n";
+    cout << "|    1. Normal  "; cout << ((currentSpeed == 1) ? "(current)" : "         "); cout << "   |\n";
+    cout << "+---------------------------+\n";
+    cout << "|    2. Fast    "; cout << ((currentSpeed == 2) ? "(current)" : "         "); cout << "   |\n";
+    cout << "+---------------------------+\n";
+    cout << "|    3. Faster  "; cout << ((currentSpeed == 4) ? "(current)" : "         "); cout << "   |\n";
+    cout << "+---------------------------+\n";
+    cout << "|    4. Instant "; cout << ((currentSpeed == 0) ? "(current)" : "         "); cout << "   |\n";
+    cout << "+===========================+\n\n";
+
+    cout << "Choose a speed (1-4) : ";
+
+    cin >> input;
+    int choice = isChoiceValid(input, 1, 4);
+    if (choice == -1)
+    {
+        return -1;
+    }
+    int speeds[] = {1, 2, 4, 0};
+    return speeds[choice - 1];
+}
+
 
 
 // display board, stats, etc.
-void Display::displayGameState(int borderThemeID, int objectThemeID, GameState gameState, int currentTurn)
+void Display::displayGameState(int borderThemeID, int objectThemeID, const GameView& view)
 {
-    clearScreen();
-    vector<char> borderTheme = Theme::borderThemes[borderThemeID];
-    vector<char> objectTheme = Theme::objectThemes[objectThemeID];
+    // Reused for every frame, once it has grown to the size of one nothing is allocated
+    static string frame;
+    frame.clear();
+    composeGameState(frame, borderThemeID, objectThemeID, view);
 
+    // another theme draws every cell differently
+    screen.draw(frame, borderThemeID * Theme::objectThemes.size() + objectThemeID);
+}
+
+// Writes the game screen to the end of frame, without drawing it
+void Display::composeGameState(string& frame, int borderThemeID, int objectThemeID, const GameView& view)
+{
     // display board
-    displayBoard(gameState.board, objectTheme, borderTheme);
+    displayBoard(frame, view.board, borderThemeID, objectThemeID);
 
     // display stats and turns
-    cout << "\n";
-    displayCharacterStats(gameState.alienAttributes,gameState.numberOfZombies ,gameState.zombieAttributes, currentTurn);
+    frame += '\n';
+    displayCharacterStats(frame, view);
 
-    cout << "\n";
+    frame += '\n';
 }
 
-void Display::displayBoard(vector<vector<char>> board, vector<char> objectTheme, vector<char> borderTheme)
+// Parts of the board that only change with the theme or the board's width, built once for them
+struct BoardStyle
+{
+    int borderThemeID = -1, objectThemeID = -1, cols = -1;
+    // What each board cell is drawn as
+    char glyphs[256];
+    // Whole lines, each ending in '\n'
+    string title, border, columnNumbers;
+    char verticalBorder;
+};
+
+static BoardStyle boardStyle;
+
+static void buildBoardStyle(int borderThemeID, int objectThemeID, int numberOfColumns)
 {
     // Object themes
     // alien, health, rock, pod, trail, arrows (up, down, left, right), space;
 
     // Border themes
     // verticalBorder, horizontalBorder1, horizontalBorder2
-
-    char objects[256];
-    objects['A'] = objectTheme[0]; objects['h'] = objectTheme[1];
-    objects['r'] = objectTheme[2]; objects['p'] = objectTheme[3];
-    objects['.'] = objectTheme[4]; objects['^'] = objectTheme[5];
-    objects['v'] = objectTheme[6]; objects['<'] = objectTheme[7];
-    objects['>'] = objectTheme[8]; objects[' '] = objectTheme[9];
-
-    objects['Z'] = 'Z'; objects['1'] = '1'; objects['2'] = '2'; objects['3'] = '3'; objects['4'] = '4'; objects['5'] = '5'; objects['6'] = '6'; objects['7'] = '7'; objects['8'] = '8'; objects['9'] = '9';
-    
-
-    int numberOfRows = board.size();
-    int numberOfColumns = board[0].size();
-
+    vector<char>& objectTheme = Theme::objectThemes[objectThemeID];
+    vector<char>& borderTheme = Theme::borderThemes[borderThemeID];
+    BoardStyle& style = boardStyle;
+    style.borderThemeID = borderThemeID;
+    style.objectThemeID = objectThemeID;
+    style.cols = numberOfColumns;
+
+    // Zombies are drawn as their number
+    for (int i = 0; i < 256; i++)
+    {
+        style.glyphs[i] = char(i);
+    }
+    style.glyphs['A'] = objectTheme[0]; style.glyphs['h'] = objectTheme[1];
+    style.glyphs['r'] = objectTheme[2]; style.glyphs['p'] = objectTheme[3];
+    style.glyphs['.'] = objectTheme[4]; style.glyphs['^'] = objectTheme[5];
+    style.glyphs['v'] = objectTheme[6]; style.glyphs['<'] = objectTheme[7];
+    style.glyphs['>'] = objectTheme[8]; style.glyphs[' '] = objectTheme[9];
 
     int boardspan = numberOfColumns * 4 + 1;
     int titleLength = 22; // length of ".: Alien vs Zombies :."
 
-    // print spaces before title
-    cout << "\n";
-    for (int i = 0; i < (boardspan - titleLength) / 2 + 4; i++)
+    // empty line, spaces before title, then the title and its underline
+    style.title = "\n";
+    style.title.append((boardspan - titleLength) / 2 + 4, ' ');
+    style.title += ".: Alien vs Zombies :.\n   ";
+    for (int i = 0; i < boardspan / 2; i++)
+    {
+        style.title += "=-";
+    }
+    style.title += "=\n";
+
+    style.border = "   ";
+    for (int col = 0; col < numberOfColumns; col++)
     {
-        cout << " ";
+        style.border += borderTheme[1];
+        style.border.append(3, borderTheme[2]);
     }
+    style.border += borderTheme[1];
+    style.border += '\n';
 
-    cout << ".: Alien vs Zombies :." << "\n";
-    cout << "   ";
-    for (int i = 0; i < boardspan / 2; i++)
+    // column number
+    style.columnNumbers = "    ";
+    for (int col = 0; col < numberOfColumns; col++)
     {
-        cout << "=-";
+        style.columnNumbers += ' ';
+        style.columnNumbers += char('a' + col);
+        style.columnNumbers += "  ";
     }
-    cout << "=";
-    cout << "\n";
+    style.columnNumbers += '\n';
 
+    style.verticalBorder = borderTheme[0];
+}
+
+// Writes value right-aligned in width characters, the way cout.width would
+static void appendNumber(string& frame, int value, int width)
+{
+    char digits[16];
+    int length = std::snprintf(digits, sizeof(digits), "%d", value);
+    if (length < width) frame.append(width - length, ' ');
+    frame.append(digits, length);
+}
+
+void Display::displayBoard(string& frame, const Board& board, int borderThemeID, int objectThemeID)
+{
+    int numberOfRows = board.getRows();
+    int numberOfColumns = board.getCols();
+
+    BoardStyle& style = boardStyle;
+    if (style.borderThemeID != borderThemeID || style.objectThemeID != objectThemeID || style.cols != numberOfColumns)
+    {
+        buildBoardStyle(borderThemeID, objectThemeID, numberOfColumns);
+    }
+
+    frame += style.title;
 
     // print out each row
     for (int row = 0; row < numberOfRows; row++)
     {
-        
-        // print out each column
-        cout << "   ";
-        for (int col = 0; col < numberOfColumns; col++)
-        {
-            cout << borderTheme[1] << borderTheme[2] << borderTheme[2] << borderTheme[2];
-        }
-        cout << borderTheme[1] << "\n";
+        frame += style.border;
 
         // print out row number
-        cout << " " << numberOfRows - row << " ";
+        frame += ' ';
+        appendNumber(frame, numberOfRows - row, 0);
+        frame += ' ';
 
+        const char* cells = board.rowData(row);
         for (int col = 0; col < numberOfColumns; col++)
         {
-            cout << borderTheme[0] << " " << objects[board[row][col]] << " ";
+            char cell[4] = {style.verticalBorder, ' ', style.glyphs[(unsigned char)cells[col]], ' '};
+            frame.append(cell, 4);
         }
-        cout << borderTheme[0] << "\n";
+        frame += style.verticalBorder;
+        frame += '\n';
     }
 
-    cout << "   ";
-    for (int col = 0; col < numberOfColumns; col++)
-    {
-        cout << borderTheme[1] << borderTheme[2] << borderTheme[2] << borderTheme[2];
-    }
-    cout << borderTheme[1] << "\n";
-
-    // print column number
-    cout << "    ";
-    for (int col = 0; col < numberOfColumns; col++)
-    {
-        cout << " " << char('a' + col) << "  ";
-    }
-    cout << "\n";
+    frame += style.border;
+    frame += style.columnNumbers;
 }
 
 
-void Display::displayCharacterStats(vector<int> alienAttributes, int numberOfZombies,vector<vector<int>> zombieAttributes, int turn)
+void Display::displayCharacterStats(string& frame, const GameView& view)
 {
     // display alien stats
+    int alienHealth = view.alienHealth;
+    int alienAttack = view.alienAttack;
+    int alienEnergy = view.alienEnergy;
+    int turn = view.currentTurn;
 
-    // AlienAttributes: {x, y, hp, attack, energy}
-    int alienHealth = alienAttributes[2];
-    int alienAttack = alienAttributes[3];
-    int alienEnergy = alienAttributes[4];
-
-    cout << (turn == 0 ? "-> " : "   ");
-    cout << "Alien    : Life ";
-    cout.width(3); cout << alienHealth;
-    cout << ", Attack ";
-    cout.width(3); cout << alienAttack;
-    cout << ", Energy (" << alienEnergy << "/5)";
-    cout << "\n";
+    frame += (turn == 0 ? "-> " : "   ");
+    frame += "Alien    : Life ";
+    appendNumber(frame, alienHealth, 3);
+    frame += ", Attack ";
+    appendNumber(frame, alienAttack, 3);
+    frame += ", Energy (";
+    appendNumber(frame, alienEnergy, 0);
+    frame += "/5)\n";
 
 
     // display zombie stats
-    for (int i = 0; i < numberOfZombies; i++)
-    {
-        int zombieHealth = zombieAttributes[i][3];
-        int zombieAttack = zombieAttributes[i][4];
-        int zombieRange = zombieAttributes[i][5];
-
-        cout << (turn == i + 1 ? "-> " : "   ");
-        cout << "Zombie " << i + 1 << " : Life ";
-        cout.width(3); cout << zombieHealth;
-        cout << ", Attack ";
-        cout.width(3); cout << zombieAttack;
-        cout << ", Range ";
-        cout.width(2); cout << zombieRange;
-        cout << "\n";
+    for (int i = 0; i < view.numberOfZombies; i++)
+    {
+        int zombieHealth = view.zombies[i].getHealth();
+        int zombieAttack = view.zombies[i].getAttack();
+        int zombieRange = view.zombies[i].getRange();
+
+        frame += (turn == i + 1 ? "-> " : "   ");
+        frame += "Zombie ";
+        appendNumber(frame, i + 1, 0);
+        frame += " : Life ";
+        appendNumber(frame, zombieHealth, 3);
+        frame += ", Attack ";
+        appendNumber(frame, zombieAttack, 3);
+        frame += ", Range ";
+        appendNumber(frame, zombieRange, 2);
+        frame += '\n';
     }
 }
 
@@ -755,49 +873,69 @@ void Display::displayCharacterStats(vector<int> alienAttributes, int numberOfZom
     {6} = alien hit a wall
     {7, x, y} = zombie x moved. y = 0: no alien in range. y = 1: alien is in range.
 */
-void Display::displayGameAction(vector<int> actions)
+void Display::displayGameAction(const vector<int>& actions)
+{
+    string message;
+    composeGameAction(message, actions);
+    screen.write(message);
+
+    pressEnterToContinue();
+}
+
+// Writes the message for actions to the end of message, without printing it
+void Display::composeGameAction(string& message, const vector<int>& actions)
 {
     int action = actions[0];
 
     // Alien gained 20 health
     if (action == 0)
     {
-        cout << "Alien found a health pack. Alien gained 20 health.";
+        message += "Alien found a health pack. Alien gained 20 health.";
     }
     else if (action == 1)
     {
         string character = (actions[1] == 0 ? "Alien" : "Zombie ");
         if (actions[1] == 1) character += actions[2] + '0';
-        cout << character <<" hit a rock. " << character << " has stopped moving.";
+        message += character + " hit a rock. " + character + " has stopped moving.";
     }
     else if (action == 2)
     {
-        cout << "Alien found a pod. The pod dealt 10 damage to zombie " << actions[1] << ".";
+        message += "Alien found a pod. The pod dealt 10 damage to zombie ";
+        appendNumber(message, actions[1], 0);
+        message += ".";
     }
     else if (action == 3)
     {
-        cout << "Alien attacked zombie " << actions[1] << ".";
+        message += "Alien attacked zombie ";
+        appendNumber(message, actions[1], 0);
+        message += ".";
     }
     else if (action == 4)
     {
-        cout << "Zombie " << actions[1] << " attacked Alien. Alien took " << actions[2] << " damage.";
+        message += "Zombie ";
+        appendNumber(message, actions[1], 0);
+        message += " attacked Alien. Alien took ";
+        appendNumber(message, actions[2], 0);
+        message += " damage.";
     }
     else if (action == 5)
     {
-        cout << "Zombie " << actions[1] << " was slain.";
+        message += "Zombie ";
+        appendNumber(message, actions[1], 0);
+        message += " was slain.";
     }
     else if (action == 6)
     {
-        cout << "Alien hit a wall. Alien has stopped moving.";
+        message += "Alien hit a wall. Alien has stopped moving.";
     }
     else if (action == 7)
     {
-        cout << "Zombie " << actions[1] << " moved. ";
-        cout << ((actions[2] == 0) ? "Alien not in range." : "Alien is in range.");
+        message += "Zombie ";
+        appendNumber(message, actions[1], 0);
+        message += " moved. ";
+        message += ((actions[2] == 0) ? "Alien not in range." : "Alien is in range.");
     }
-    cout << "\n";
-
-    pressEnterToContinue();
+    message += "\n";
 }
 
 // (direction, {{arrow row, arrow column}})
@@ -828,6 +966,32 @@ void Display::displayHint(int maxRows, pair<int, vector<vector<int>>> hints)
     cout << arrows.size() + 1 << ". " << directions[direction] << "\n";
 }
 
+// Tell the player if the hint ran out of time before trying every arrow rotation
+void Display::displayHintDepth(int depthReached, bool complete)
+{
+    if (complete) return;
+    cout << "      (ran out of time, only tried up to " << std::max(depthReached, 0) << " arrow rotations)\n";
+}
+
+// Tell the player how many zombie rounds the lookahead hint weighed
+void Display::displayHintRounds(int roundsReached, int rounds)
+{
+    if (roundsReached == 0)
+    {
+        cout << "      (ran out of nodes, this is the normal hint)\n";
+        return;
+    }
+    cout << "      (looked " << roundsReached << " of " << rounds << " zombie rounds ahead)\n";
+}
+
+// {nodes visited, transposition table hits, transposition table stores, directions from hint cache}
+void Display::displayHintStats(vector<long long> stats)
+{
+    cout << "hint-stats: " << stats[0] << " nodes visited, ";
+    cout << stats[1] << " transposition table hits, ";
+    cout << stats[2] << " subtrees stored, ";
+    cout << stats[3] << " directions reused from the last hint\n";
+}
 
 // Adds letters to the strings via pass by reference
 void Display::addLetter(bool outcome, string& s1, string& s2, string& s3, string& s4, string& s5)
@@ -852,57 +1016,37 @@ void Display::addLetter(bool outcome, string& s1, string& s2, string& s3, string
     } 
 }
 
-// Cycles the string
-string Display::cycleString(string& s)
+// true: win
+// false: lose
+// frameNumber: how many letters the banner has scrolled by
+void Display::displayWinLose(bool outcome, int frameNumber)
 {
-    string newString;
-    for (int i = 1; i < s.length(); i++)
-    {
-        newString += s[i];
-    }
-    newString += s[0];
-    return newString;
+    string frame;
+    composeWinLose(frame, outcome, frameNumber);
+    screen.draw(frame, -1);
 }
 
-
-// true: win
-// false: lose
-// duration (0.1s) duration = 10 -> 1s
-void Display::displayWinLose(bool outcome, int duration)
+// Writes a frame of the win/lose banner to the end of frame, without drawing it
+void Display::composeWinLose(string& frame, bool outcome, int frameNumber)
 {
     string s1, s2, s3, s4, s5;
     addLetter(outcome, s1, s2, s3, s4, s5);
 
-    for (int i = 0; i < duration; i++)
-    {   
-        cout << "\n";
-        for (int j = 0; j < s1.length() + 10; j++)
-        {
-            cout << "=";
-        }
-        cout << "\n";
-
-        cout << "||   "  << s1 << "   ||"  << "\n";
-        cout << "||   "  << s2 << "   ||"  << "\n";
-        cout << "||   "  << s3 << "   ||"  << "\n";
-        cout << "||   "  << s4 << "   ||"  << "\n";
-        cout << "||   "  << s5 << "   ||"  << "\n";
+    frame += '\n';
+    frame.append(s1.length() + 10, '=');
+    frame += '\n';
 
-        for (int j = 0; j < s1.length() + 10; j++)
-        {
-            cout << "=";
-        }
-        cout << "\n";
-
-        s1 = cycleString(s1);
-        s2 = cycleString(s2);
-        s3 = cycleString(s3);
-        s4 = cycleString(s4);
-        s5 = cycleString(s5);
-
-        pauseForMilliseconds(100);
-        clearScreen();
+    for (string* s : {&s1, &s2, &s3, &s4, &s5})
+    {
+        int shift = frameNumber % s->length();
+        frame += "||   ";
+        frame.append(*s, shift, string::npos);
+        frame.append(*s, 0, shift);
+        frame += "   ||\n";
     }
+
+    frame.append(s1.length() + 10, '=');
+    frame += '\n';
 }
 
 // used for debugging
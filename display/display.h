@@ -5,6 +5,7 @@
 #include <utility>
 #include <string>
 #include "../game/game_state.h"
+#include "../game/game_view.h"
 
 using std::string;
 using std::vector;
@@ -36,21 +37,28 @@ namespace Display
     void displayHelp();
     void displayStats(vector<int> stats);
     void displayNoEnergy();
+    void displayNothingToUndo(char undoOrRedo);
     int getSaveFileChoice(vector<int> saveFiles);
     int getLoadFileChoice(vector<int> saveFiles);
     int deleteSaveFile();
     int quitGame();
     pair<int, int> getArrowCoordinates(int numberOfRows);
     int getNewArrowDirection();
+    int getAnimationSpeed(int currentSpeed);
 
-    void displayGameState(int borderThemeID, int objectThemeID, GameState gameState, int currentTurn);
-    void displayCharacterStats(vector<int> alienAttributes, int numberOfZombies, vector<vector<int>> zombieAttributes, int turn);
-    void displayBoard(vector<vector<char>> board, vector<char> objectTheme, vector<char> borderTheme);
-    void displayGameAction(vector<int> actions);
+    void displayGameState(int borderThemeID, int objectThemeID, const GameView& view);
+    void composeGameState(string& frame, int borderThemeID, int objectThemeID, const GameView& view);
+    void displayCharacterStats(string& frame, const GameView& view);
+    void displayBoard(string& frame, const Board& board, int borderThemeID, int objectThemeID);
+    void displayGameAction(const vector<int>& actions);
+    void composeGameAction(string& message, const vector<int>& actions);
     void displayHint(int maxRows, pair<int, vector<vector<int>>> hints);
+    void displayHintDepth(int depthReached, bool complete);
+    void displayHintRounds(int roundsReached, int rounds);
+    void displayHintStats(vector<long long> stats);
     void addLetter(bool outcome, string& s1, string& s2, string& s3, string& s4, string& s5);
-    string cycleString(string& s);
-    void displayWinLose(bool outcome, int duration);
+    void displayWinLose(bool outcome, int frameNumber);
+    void composeWinLose(string& frame, bool outcome, int frameNumber);
     void displayMessage(string message);
 }
 
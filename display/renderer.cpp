@@ -0,0 +1,108 @@
+#include "renderer.h"
+#include "display.h"
+
+void TerminalRenderer::drawGame(Game& game, int borderThemeID, int objectThemeID)
+{
+    Display::displayGameState(borderThemeID, objectThemeID, game.getView());
+}
+
+void TerminalRenderer::drawStep(Game& game, int borderThemeID, int objectThemeID, int millisecond)
+{
+    if (this->clock.isSkipping()) return;
+    Display::displayGameState(borderThemeID, objectThemeID, game.getView());
+    this->clock.wait(millisecond);
+}
+
+void TerminalRenderer::drawAction(Game& game, int borderThemeID, int objectThemeID, const vector<int>& action)
+{
+    if (this->clock.isSkipping()) return;
+    Display::displayGameState(borderThemeID, objectThemeID, game.getView());
+    Display::displayGameAction(action);
+}
+
+// Scroll the win/lose banner for 10 seconds (at normal speed), or until the player presses Enter
+void TerminalRenderer::drawWinLose(bool outcome)
+{
+    this->clock.startTurn();
+    if (this->clock.isSkipping())
+    {
+        // Instant speed still tells the player how the game ended
+        Display::displayWinLose(outcome, 0);
+        Display::pressEnterToContinue();
+    }
+    for (int i = 0; i < 100 && !this->clock.isSkipping(); i++)
+    {
+        Display::displayWinLose(outcome, i);
+        this->clock.wait(100);
+    }
+    Display::clearScreen();
+}
+
+void TerminalRenderer::startTurn()
+{
+    this->clock.startTurn();
+}
+
+int TerminalRenderer::getSpeed()
+{
+    return this->clock.getSpeed();
+}
+
+void TerminalRenderer::setSpeed(int speed)
+{
+    this->clock.setSpeed(speed);
+}
+
+
+RecordingRenderer::RecordingRenderer(const string& path) : file(path)
+{
+    this->numOfFrames = 0;
+}
+
+// Write the game as it is now as the next frame
+void RecordingRenderer::record(Game& game, int borderThemeID, int objectThemeID)
+{
+    this->frame.clear();
+    Display::composeGameState(this->frame, borderThemeID, objectThemeID, game.getView());
+    this->file << "--- frame " << ++this->numOfFrames << " ---\n" << this->frame;
+}
+
+void RecordingRenderer::drawGame(Game& game, int borderThemeID, int objectThemeID)
+{
+    this->record(game, borderThemeID, objectThemeID);
+}
+
+void RecordingRenderer::drawStep(Game& game, int borderThemeID, int objectThemeID, int)
+{
+    this->record(game, borderThemeID, objectThemeID);
+}
+
+void RecordingRenderer::drawAction(Game& game, int borderThemeID, int objectThemeID, const vector<int>& action)
+{
+    this->record(game, borderThemeID, objectThemeID);
+    this->frame.clear();
+    Display::composeGameAction(this->frame, action);
+    this->file << this->frame;
+}
+
+void RecordingRenderer::drawWinLose(bool outcome)
+{
+    this->frame.clear();
+    Display::composeWinLose(this->frame, outcome, 0);
+    this->file << "--- frame " << ++this->numOfFrames << " ---\n" << this->frame;
+    this->file.flush();
+}
+
+// Nothing waits, so there is no speed to change
+void RecordingRenderer::startTurn()
+{
+}
+
+int RecordingRenderer::getSpeed()
+{
+    return 0;
+}
+
+void RecordingRenderer::setSpeed(int)
+{
+}
@@ -0,0 +1,82 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include "animation_clock.h"
+#include "../game/game.h"
+
+using std::vector;
+using std::string;
+
+/*
+    Where Controller sends the game's frames, picked when it is built as Controller<Renderer>
+
+    Every renderer has the same members, so Controller calls them directly without virtual calls:
+    drawsFrames       false if nothing is ever shown, Controller then doesn't work out what to show
+    drawGame          the game as it is now
+    drawStep          a step of a move, shown for millisecond at normal speed
+    drawAction        a step of a move and a message about it, see Display::displayGameAction
+    drawWinLose       how the game ended
+    startTurn         a new turn's animation begins, see AnimationClock
+    getSpeed/setSpeed see AnimationClock
+*/
+
+// Draws on the terminal, paced by an AnimationClock
+class TerminalRenderer
+{
+    private:
+        AnimationClock clock;
+
+    public:
+        static constexpr bool drawsFrames = true;
+
+        void drawGame(Game& game, int borderThemeID, int objectThemeID);
+        void drawStep(Game& game, int borderThemeID, int objectThemeID, int millisecond);
+        void drawAction(Game& game, int borderThemeID, int objectThemeID, const vector<int>& action);
+        void drawWinLose(bool outcome);
+        void startTurn();
+        int getSpeed();
+        void setSpeed(int speed);
+};
+
+// Shows nothing, every member is empty and inline so a call compiles to nothing
+class NullRenderer
+{
+    public:
+        static constexpr bool drawsFrames = false;
+
+        void drawGame(Game&, int, int) {}
+        void drawStep(Game&, int, int, int) {}
+        void drawAction(Game&, int, int, const vector<int>&) {}
+        void drawWinLose(bool) {}
+        void startTurn() {}
+        int getSpeed() { return 0; }
+        void setSpeed(int) {}
+};
+
+// Writes every frame and message in full to a file, without escapes or waiting, eg. to compare two runs
+class RecordingRenderer
+{
+    private:
+        std::ofstream file;
+        string frame;
+        int numOfFrames;
+
+        void record(Game& game, int borderThemeID, int objectThemeID);
+
+    public:
+        static constexpr bool drawsFrames = true;
+
+        RecordingRenderer(const string& path);
+        void drawGame(Game& game, int borderThemeID, int objectThemeID);
+        void drawStep(Game& game, int borderThemeID, int objectThemeID, int millisecond);
+        void drawAction(Game& game, int borderThemeID, int objectThemeID, const vector<int>& action);
+        void drawWinLose(bool outcome);
+        void startTurn();
+        int getSpeed();
+        void setSpeed(int speed);
+};
+
+#endif
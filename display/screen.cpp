@@ -0,0 +1,226 @@
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include "screen.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <io.h>
+#elif defined(__linux__) || defined(__APPLE__)
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#endif
+
+using std::cout;
+
+// Messages, prompts and the player's input printed under the frame need this many lines too
+const int linesBelowFrame = 10;
+
+// A run of this many unchanged characters costs about as much as moving the cursor past it
+const int maxGapInRun = 8;
+
+Screen::Screen()
+{
+    this->shownKey = -1;
+    this->terminalRows = 0;
+    this->terminalCols = 0;
+    this->valid = false;
+    this->fixedSize = false;
+
+    #if defined(_WIN32)
+        // The escapes need virtual terminal processing, which older consoles don't have
+        HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        this->isTerminal = _isatty(_fileno(stdout)) && GetConsoleMode(handle, &mode)
+            && SetConsoleMode(handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    #elif defined(__linux__) || defined(__APPLE__)
+        this->isTerminal = isatty(STDOUT_FILENO);
+    #else
+        this->isTerminal = false;
+    #endif
+}
+
+// A terminal of rows x cols that render draws on, for measuring frames without printing them
+Screen::Screen(int rows, int cols)
+{
+    this->shownKey = -1;
+    this->terminalRows = rows;
+    this->terminalCols = cols;
+    this->valid = false;
+    this->isTerminal = true;
+    this->fixedSize = true;
+}
+
+bool Screen::readTerminalSize(int& rows, int& cols)
+{
+    if (this->fixedSize)
+    {
+        rows = this->terminalRows;
+        cols = this->terminalCols;
+        return true;
+    }
+
+    #if defined(_WIN32)
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) return false;
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+        cols = info.srWindow.Right - info.srWindow.Left + 1;
+        return true;
+    #elif defined(__linux__) || defined(__APPLE__)
+        winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0) return false;
+        rows = size.ws_row;
+        cols = size.ws_col;
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+// Draw the frame, key tells frames that look alike but can't be diffed apart (eg. the theme)
+void Screen::draw(const string& frame, int key)
+{
+    this->write(this->render(frame, key));
+}
+
+// What draw would send for the frame, from here on the screen holds the frame
+const string& Screen::render(const string& frame, int key)
+{
+    this->output.clear();
+    if (!this->isTerminal)
+    {
+        this->output += frame;
+        return this->output;
+    }
+
+    int rows = 0, cols = 0;
+    bool sized = this->readTerminalSize(rows, cols);
+    bool resized = !sized || rows != this->terminalRows || cols != this->terminalCols;
+    this->terminalRows = rows;
+    this->terminalCols = cols;
+
+    // Cursor positions are only right if the frame never scrolled or wrapped
+    int numOfLines = 0, lineStart = 0;
+    bool fits = sized;
+    for (int i = 0; i < (int)frame.size(); i++)
+    {
+        if (frame[i] != '\n') continue;
+        if (i - lineStart >= cols) fits = false;
+        numOfLines++;
+        lineStart = i + 1;
+    }
+    if (numOfLines + linesBelowFrame > rows) fits = false;
+
+    int shownLines = 0;
+    for (int i = 0; i < (int)this->shown.size(); i++)
+    {
+        if (this->shown[i] == '\n') shownLines++;
+    }
+
+    if (this->valid && !resized && fits && key == this->shownKey && numOfLines == shownLines)
+    {
+        this->drawChanges(frame);
+    }
+    else
+    {
+        this->repaint(frame);
+    }
+
+    this->shown = frame;
+    this->shownKey = key;
+    this->valid = fits;
+    return this->output;
+}
+
+// Send text to the terminal in one write, after anything still buffered in cout
+void Screen::write(const string& text)
+{
+    cout.flush();
+    std::fflush(stdout);
+
+    #if defined(__linux__) || defined(__APPLE__)
+        int written = 0;
+        while (written < (int)text.size())
+        {
+            int result = ::write(STDOUT_FILENO, text.data() + written, text.size() - written);
+            if (result <= 0) return;
+            written += result;
+        }
+    #else
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        std::fflush(stdout);
+    #endif
+}
+
+// Clear the terminal, the next frame is drawn in full
+void Screen::clear()
+{
+    if (this->isTerminal) this->write("\033[H\033[2J\033[3J");
+    this->valid = false;
+}
+
+// Draw the whole frame from the next draw on, call after printing over the screen
+void Screen::invalidate()
+{
+    this->valid = false;
+}
+
+void Screen::repaint(const string& frame)
+{
+    this->output += "\033[H\033[2J\033[3J";
+    this->output += frame;
+}
+
+void Screen::drawChanges(const string& frame)
+{
+    const string& shown = this->shown;
+    int before = 0, after = 0, row = 0;
+    for (; after < (int)frame.size(); row++)
+    {
+        int beforeEnd = shown.find('\n', before);
+        int afterEnd = frame.find('\n', after);
+        int beforeLength = beforeEnd - before, afterLength = afterEnd - after;
+
+        // Find runs of changed characters, runs close together are sent as one
+        // Anything past the end of the line that was shown counts as changed
+        int col = 0;
+        while (col < afterLength)
+        {
+            if (col < beforeLength && shown[before + col] == frame[after + col])
+            {
+                col++;
+                continue;
+            }
+
+            int start = col, end = col + 1;
+            for (col++; col < afterLength && col - end < maxGapInRun; col++)
+            {
+                if (col >= beforeLength || shown[before + col] != frame[after + col]) end = col + 1;
+            }
+            this->moveCursor(row, start);
+            this->output.append(frame, after + start, end - start);
+            col = end;
+        }
+
+        if (afterLength < beforeLength)
+        {
+            this->moveCursor(row, afterLength);
+            this->output += "\033[K";
+        }
+
+        before = beforeEnd + 1;
+        after = afterEnd + 1;
+    }
+
+    // Erase what was printed under the last frame and leave the cursor where printing it started
+    this->moveCursor(row, 0);
+    this->output += "\033[J";
+}
+
+// 0-indexed row and column of the frame, the terminal counts from 1
+void Screen::moveCursor(int row, int col)
+{
+    char escape[24];
+    int length = std::snprintf(escape, sizeof(escape), "\033[%d;%dH", row + 1, col + 1);
+    this->output.append(escape, length);
+}
@@ -0,0 +1,47 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include <string>
+
+using std::string;
+
+/*
+    Double-buffered terminal screen
+
+    A frame is one string of lines, each ending in '\n'. Screen keeps the last frame it drew, the next
+    frame only sends the characters that changed, each run behind an ANSI cursor-positioning escape,
+    instead of clearing the screen and printing it all again. Whatever was printed under the frame
+    since (messages, prompts, the player's input) is erased. Everything a draw sends is written at once.
+
+    The whole frame is drawn again when the terminal is resized, the frame changes shape or key
+    (another theme, another screen), invalidate was called, or the frame doesn't fit the terminal.
+    If the output is not a terminal every frame is printed in full without any escapes.
+*/
+class Screen
+{
+    private:
+        string shown;
+        int shownKey;
+        int terminalRows, terminalCols;
+        bool valid;
+        bool isTerminal;
+        // Size given to the constructor, the real terminal's size is never read
+        bool fixedSize;
+        string output;
+
+        bool readTerminalSize(int& rows, int& cols);
+        void repaint(const string& frame);
+        void drawChanges(const string& frame);
+        void moveCursor(int row, int col);
+
+    public:
+        Screen();
+        Screen(int rows, int cols);
+        void draw(const string& frame, int key);
+        const string& render(const string& frame, int key);
+        void write(const string& text);
+        void clear();
+        void invalidate();
+};
+
+#endif
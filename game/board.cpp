@@ -0,0 +1,95 @@
+#include "board.h"
+#include <algorithm>
+
+Board::Board()
+{
+    this->rows = 0;
+    this->cols = 0;
+    this->wordsPerRow = 0;
+    this->wordsPerCol = 0;
+}
+
+Board::Board(int rows, int cols, char fill)
+{
+    this->resize(rows, cols, fill);
+}
+
+// Size the board and set every cell to fill
+void Board::resize(int rows, int cols, char fill)
+{
+    this->rows = rows;
+    this->cols = cols;
+    this->cells.assign(rows * cols, fill);
+    this->wordsPerRow = (cols + 63) / 64;
+    this->wordsPerCol = (rows + 63) / 64;
+
+    int fillType = cellTable[(unsigned char)fill];
+    this->planes.assign(numOfCellTypes * rows * this->wordsPerRow, 0);
+    this->openColumns.assign(cols * this->wordsPerCol, 0);
+    this->occupants.assign(rows * cols, 0);
+    for(int row = 0; row < rows; row++)
+    {
+        for(int col = 0; col < cols; col++)
+        {
+            this->setBit(this->planes, (fillType * rows + row) * this->wordsPerRow, col, true);
+            if (isOpen(fillType)) this->setBit(this->openColumns, col * this->wordsPerCol, row, true);
+        }
+    }
+}
+
+void Board::clear()
+{
+    this->rows = 0;
+    this->cols = 0;
+    this->wordsPerRow = 0;
+    this->wordsPerCol = 0;
+    this->cells.clear();
+    this->planes.clear();
+    this->openColumns.clear();
+    this->occupants.clear();
+}
+
+// Number of empty or trail cells right after (row, col) going in direction (U, D, L, R)
+// Stops at the first other cell or the edge of the board, whichever is closer
+int Board::openRun(int row, int col, int direction) const
+{
+    // Going up or down walks a column, otherwise a row
+    const uint64_t* line;
+    int start, length;
+    if (direction < 2)
+    {
+        line = this->openColumns.data() + col * this->wordsPerCol;
+        start = row;
+        length = this->rows;
+    }
+    else
+    {
+        line = this->planes.data() + (EMPTY * this->rows + row) * this->wordsPerRow;
+        start = col;
+        length = this->cols;
+    }
+
+    if (direction == 1 || direction == 3)
+    {
+        // Lowest blocked bit above start
+        for(int position = start + 1; position < length; position = (position | 63) + 1)
+        {
+            int word = position >> 6;
+            uint64_t open = direction == 1 ? line[word] : line[word] | this->planes[(TRAIL * this->rows + row) * this->wordsPerRow + word];
+            uint64_t blocked = ~open & (~(uint64_t)0 << (position & 63));
+            if (blocked) return std::min(word * 64 + __builtin_ctzll(blocked), length) - start - 1;
+        }
+        return length - start - 1;
+    }
+
+    // Highest blocked bit below start
+    for(int position = start - 1; position >= 0; position = (position & ~63) - 1)
+    {
+        int word = position >> 6;
+        uint64_t open = direction == 0 ? line[word] : line[word] | this->planes[(TRAIL * this->rows + row) * this->wordsPerRow + word];
+        uint64_t below = (position & 63) == 63 ? ~(uint64_t)0 : ((uint64_t)1 << ((position & 63) + 1)) - 1;
+        uint64_t blocked = ~open & below;
+        if (blocked) return start - (word * 64 + 63 - __builtin_clzll(blocked)) - 1;
+    }
+    return start;
+}
@@ -0,0 +1,202 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <vector>
+#include <array>
+#include <cstdint>
+
+using std::vector;
+
+/*
+    What a cell holds, numbered the same way checkCoordinate reports it
+
+    arrows = 0-3 (up, down, left, right)
+    health = 4
+    pod = 5
+    rock = 6
+    empty space = 7
+    alien = 8
+    zombie = 9
+    trail = 10
+*/
+enum Cell : unsigned char
+{
+    ARROW_UP = 0,
+    ARROW_DOWN = 1,
+    ARROW_LEFT = 2,
+    ARROW_RIGHT = 3,
+    HEALTH = 4,
+    POD = 5,
+    ROCK = 6,
+    EMPTY = 7,
+    ALIEN = 8,
+    ZOMBIE = 9,
+    TRAIL = 10
+};
+
+const int numOfCellTypes = 11;
+
+// Build the char -> cell code table at compile time
+// Anything that is not a known game object can only be a zombie
+constexpr std::array<unsigned char, 256> makeCellTable()
+{
+    std::array<unsigned char, 256> table {};
+    for (int i = 0; i < 256; i++)
+    {
+        table[i] = ZOMBIE;
+    }
+    table[(unsigned char)'^'] = ARROW_UP;
+    table[(unsigned char)'v'] = ARROW_DOWN;
+    table[(unsigned char)'<'] = ARROW_LEFT;
+    table[(unsigned char)'>'] = ARROW_RIGHT;
+    table[(unsigned char)'h'] = HEALTH;
+    table[(unsigned char)'p'] = POD;
+    table[(unsigned char)'r'] = ROCK;
+    table[(unsigned char)' '] = EMPTY;
+    table[(unsigned char)'A'] = ALIEN;
+    table[(unsigned char)'.'] = TRAIL;
+    return table;
+}
+
+inline constexpr std::array<unsigned char, 256> cellTable = makeCellTable();
+
+// Game board stored as one contiguous row-major buffer of chars
+// Alongside the chars, one bitboard plane per Cell marks where that kind of cell is
+// Each row of a plane is wordsPerRow 64-bit words, bit (col % 64) of word (col / 64)
+// Empty space and trails are also kept column by column, so runs of them can be skipped both ways
+// Zombies are drawn as '1'-'9', or 'Z' past 9, so which zombie is on a cell is kept in a separate layer of IDs
+class Board
+{
+    private:
+        int rows, cols;
+        vector<char> cells;
+        int wordsPerRow, wordsPerCol;
+        // [cell type][row][word]
+        vector<uint64_t> planes;
+        // [col][word], bit (row % 64) of word (row / 64) set if the cell is empty space or a trail
+        vector<uint64_t> openColumns;
+        // Zombie ID per cell, only meaningful where the cell is a zombie
+        vector<uint32_t> occupants;
+
+        void setBit(vector<uint64_t>& plane, int index, int bit, bool value);
+        static bool isOpen(int cellType);
+
+    public:
+        Board();
+        Board(int rows, int cols, char fill = ' ');
+        void resize(int rows, int cols, char fill = ' ');
+        void clear();
+        int getRows() const;
+        int getCols() const;
+        bool isInside(int row, int col) const;
+        char get(int row, int col) const;
+        void set(int row, int col, char object);
+        Cell cellAt(int row, int col) const;
+        int checkCell(int row, int col) const;
+        const char* rowData(int row) const;
+        uint64_t planeWord(Cell cellType, int row, int word) const;
+        int getWordsPerRow() const;
+        int openRun(int row, int col, int direction) const;
+        void setZombie(int row, int col, uint32_t id);
+        uint32_t getZombieID(int row, int col) const;
+        static char zombieSymbol(uint32_t id);
+};
+
+// The accessors below are hit on every step of the hint search, keep them inline
+inline int Board::getRows() const
+{
+    return this->rows;
+}
+
+inline int Board::getCols() const
+{
+    return this->cols;
+}
+
+inline bool Board::isInside(int row, int col) const
+{
+    return row >= 0 && row < this->rows && col >= 0 && col < this->cols;
+}
+
+inline char Board::get(int row, int col) const
+{
+    return this->cells[row * this->cols + col];
+}
+
+inline bool Board::isOpen(int cellType)
+{
+    return cellType == EMPTY || cellType == TRAIL;
+}
+
+inline void Board::setBit(vector<uint64_t>& plane, int index, int bit, bool value)
+{
+    uint64_t mask = (uint64_t)1 << (bit & 63);
+    if (value) plane[index + (bit >> 6)] |= mask;
+    else plane[index + (bit >> 6)] &= ~mask;
+}
+
+// Every change to the board goes through here, which keeps the planes in sync
+inline void Board::set(int row, int col, char object)
+{
+    char& cell = this->cells[row * this->cols + col];
+    int oldType = cellTable[(unsigned char)cell];
+    int newType = cellTable[(unsigned char)object];
+    cell = object;
+    if (oldType == newType) return;
+
+    this->setBit(this->planes, (oldType * this->rows + row) * this->wordsPerRow, col, false);
+    this->setBit(this->planes, (newType * this->rows + row) * this->wordsPerRow, col, true);
+    if (isOpen(oldType) != isOpen(newType))
+    {
+        this->setBit(this->openColumns, col * this->wordsPerCol, row, isOpen(newType));
+    }
+}
+
+inline Cell Board::cellAt(int row, int col) const
+{
+    return Cell(cellTable[(unsigned char)this->cells[row * this->cols + col]]);
+}
+
+// Same as cellAt, but -1 if the cell is outside the board
+inline int Board::checkCell(int row, int col) const
+{
+    if (!this->isInside(row, col)) return -1;
+    return this->cellAt(row, col);
+}
+
+inline const char* Board::rowData(int row) const
+{
+    return this->cells.data() + row * this->cols;
+}
+
+// Word of row in the plane of cellType, see getWordsPerRow
+inline uint64_t Board::planeWord(Cell cellType, int row, int word) const
+{
+    return this->planes[(cellType * this->rows + row) * this->wordsPerRow + word];
+}
+
+inline int Board::getWordsPerRow() const
+{
+    return this->wordsPerRow;
+}
+
+// Put zombie id on a cell, the only way a zombie gets onto the board
+inline void Board::setZombie(int row, int col, uint32_t id)
+{
+    this->set(row, col, zombieSymbol(id));
+    this->occupants[row * this->cols + col] = id;
+}
+
+// ID of the zombie on a cell, only call it on a zombie cell
+inline uint32_t Board::getZombieID(int row, int col) const
+{
+    return this->occupants[row * this->cols + col];
+}
+
+// How zombie id is drawn on the board
+inline char Board::zombieSymbol(uint32_t id)
+{
+    return id <= 9 ? '0' + id : 'Z';
+}
+
+#endif
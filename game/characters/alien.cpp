@@ -1,13 +1,13 @@
 #include "alien.h"
 #include <algorithm>
 
-// Initialize Alien stats
+// Initialize Alien stats, energy from a save file is kept within 0 to maxEnergy
 void Alien::init(pair<int,int> coordinates, int health, int energy)
 {
     this->health = health;
     this->attack = 0;
     this->coordinates = coordinates;
-    this->energy = energy;
+    this->energy = std::clamp(energy, 0, maxEnergy);
 }
 
 void Alien::receiveAttack(int damage)
@@ -28,9 +28,9 @@ void Alien::incAttack(int amount)
 void Alien::incEnergy()
 {
     this->energy += 2;
-    if (this->energy > 5)
+    if (this->energy > maxEnergy)
     {
-        this->energy = 5;
+        this->energy = maxEnergy;
     }
 }
 
@@ -9,9 +9,12 @@ class Alien
     private : 
         pair<int,int> coordinates;
         int health, attack, energy;
-        const int maxHealth = 200, maxEnergy = 5;
+        static constexpr int maxHealth = 200;
 
     public:
+        // Energy is capped here, every arrow the alien can rotate in one turn costs 1
+        static constexpr int maxEnergy = 5;
+
         void init(pair<int,int> coordinates, int health, int energy);
         void receiveAttack(int damage);
         void incHealth(int amount);
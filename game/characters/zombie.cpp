@@ -23,7 +23,7 @@ void Zombie::move(int rowDelta, int colDelta)
     this->coordinates.second += colDelta;
 }
 
-bool Zombie::isAlive()
+bool Zombie::isAlive() const
 {
     return this->health > 0;
 }
@@ -52,27 +52,27 @@ void Zombie::setID(int ID)
 }
 
 // Getters
-pair<int,int> Zombie::getCoordinates()
+pair<int,int> Zombie::getCoordinates() const
 {
     return this->coordinates;
 }
 
-int Zombie::getHealth()
+int Zombie::getHealth() const
 {
     return this->health;
 }
 
-int Zombie::getAttack()
+int Zombie::getAttack() const
 {
     return this->attack;
 }
 
-int Zombie::getRange()
+int Zombie::getRange() const
 {
     return this->range;
 }
 
-int Zombie::getID()
+int Zombie::getID() const
 {
     return this->ID;
 }
\ No newline at end of file
@@ -14,14 +14,14 @@ class Zombie
         void init(int health, int attack, int range, pair<int,int> coordinates);
         void receiveAttack(int damage);
         void move(int rowDelta, int colDelta);
-        bool isAlive();
+        bool isAlive() const;
         bool isInRange(pair<int,int>& coordinates);
         void setID(int ID);
-        pair<int,int> getCoordinates();
-        int getHealth();
-        int getAttack();
-        int getRange();
-        int getID();
+        pair<int,int> getCoordinates() const;
+        int getHealth() const;
+        int getAttack() const;
+        int getRange() const;
+        int getID() const;
 };
 
 #endif
\ No newline at end of file
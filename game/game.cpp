@@ -5,25 +5,44 @@
 #include <ctime>
 #include <climits>
 #include <string>
+#include <thread>
+#include <chrono>
+#include <atomic>
 
 // Clear the old data if exists
 void Game::cleanOldData()
 {
     this->board.clear();
     this->zombies.clear();
-    while (!this->turnQueue.empty()) this->turnQueue.pop();
+    this->hintStats = {0, 0, 0, 0};
+    this->hintCache.invalidateAll();
+    this->move.mover = -1;
+    this->journal.clear();
+    this->checkpoints.clear();
+}
+
+// Random number in [0, n) from this game's engine
+int Game::randomInt(int n)
+{
+    return this->randomEngine() % n;
 }
 
 // Get the ID of the zombie at specified coordinates
 int Game::getZombieIDAt(pair<int,int> coordinates)
 {
     if (this->checkCoordinate(coordinates, 4) != 9) return -1;
-    return this->board[coordinates.first][coordinates.second]-'0';
+    return this->board.getZombieID(coordinates.first, coordinates.second);
 }
 
 // init rows, columns (new game), number of zombies
 // player will set board game dimensions and number of zombies
 void Game::newGame(int rows, int cols, int numofZombies, int difficulty)
+{
+    this->newGame(rows, cols, numofZombies, difficulty, time(NULL));
+}
+
+// Same as above, but the board, the zombies and everything random in the game come from seed
+void Game::newGame(int rows, int cols, int numofZombies, int difficulty, uint64_t seed)
 {
     this->cleanOldData();
 
@@ -41,10 +60,15 @@ void Game::newGame(int rows, int cols, int numofZombies, int difficulty)
     this->numOfZombies = numofZombies;
     this->healthLost = 0;
     this->attackGained = 0;
+    this->numberOfPlayerTurns = 0;
     this->numOfZombiesAlive = numOfZombies;
 
+    // Everything random in this game comes from its own engine, so games on different threads don't share state
+    this->randomEngine.seed(seed);
+
     // Generate new board
-    generateNewBoard();
+    vector<pair<int,int>> zombieCoordinates;
+    generateNewBoard(zombieCoordinates);
 
     
     // Switch case sets boundaries depending on difficulty picked
@@ -82,10 +106,6 @@ void Game::newGame(int rows, int cols, int numofZombies, int difficulty)
             break;
     }
 
-    // Seed randomness for these two as they can't be used interchangeably
-    srand(time(NULL));
-    auto rng = std::default_random_engine(time(NULL));;
-
 
     // Loop to determine random stats for each zombie and create Zombie objects
     std::pair<int, int> newZombieCoordinates;
@@ -97,28 +117,30 @@ void Game::newGame(int rows, int cols, int numofZombies, int difficulty)
         std::uniform_int_distribution<> range(rangeLowerBound, rangeUpperBound);
         
         // Randomly assign zombies with one of two options for health
-        if(rand() % 2)
+        if(this->randomInt(2))
             health = healthLowerBound;
         else
             health = healthUpperBound;
         
         // Get coordinates for each zombie ID in generated board
-        newZombieCoordinates = getZombieCoordinatesFromBoard(i);
+        newZombieCoordinates = zombieCoordinates[i-1];
         
         // Create Zombie objects
         Zombie zombie;
-        zombie.init(health, attack(rng), range(rng), newZombieCoordinates);
+        zombie.init(health, attack(this->randomEngine), range(this->randomEngine), newZombieCoordinates);
 
         // Assign an ID for each zombie, starting from 1
         zombie.setID(i);
         this->zombies.push_back(zombie);
     }
 
-    // Initialize turns
-    for(int i = 0; i <= numOfZombies; i++)
-    {
-        this->turnQueue.push(i);
-    }
+    // Initialize turns, alien first then zombies by ID
+    this->turnOrder.reset(this->numOfZombies);
+
+    this->buildThreatMap();
+    this->buildZombieGrid();
+    this->buildZombieMoves();
+    this->startJournal();
 }
 
 // Load game from GameState
@@ -132,16 +154,12 @@ void Game::loadGame(GameState& state)
 
     this->healthLost = state.healthLost;
     this->attackGained = state.attackGained;
+    this->numberOfPlayerTurns = state.numberOfPlayerTurns;
     this->gameOver = false;
+    // Carry on with the same random numbers the game would have drawn had it not been saved
+    this->randomEngine.restore(state.randomSeed, state.randomPosition);
 
-    this->board.resize(this->rows, vector<char> (this->cols));
-    for(int i = 0; i < this->rows; i++) 
-    {
-        for(int j = 0; j < this->cols; j++)
-        {
-            this->board[i][j] = state.board[i][j];
-        }
-    }
+    this->board = state.board;
 
     // Initialize alien  {row, col, hp, atk, energy}
     std::pair<int, int> alienCoordinates;
@@ -172,16 +190,301 @@ void Game::loadGame(GameState& state)
         zombie.setID(state.zombieAttributes[i][0]);
         this->zombies[i] = zombie;
         this->numOfZombiesAlive += this->zombies[i].isAlive();
+
+        // The board only says a zombie is there, which one comes from its attributes
+        if (this->board.cellAt(currentZombieCoordinates.first, currentZombieCoordinates.second) == ZOMBIE)
+        {
+            this->board.setZombie(currentZombieCoordinates.first, currentZombieCoordinates.second, zombie.getID());
+        }
+    }
+    // A dead zombie's attributes keep the cell it died on, a living zombie may have moved onto it since
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        pair<int,int> coordinates = this->zombies[i].getCoordinates();
+        if (this->zombies[i].isAlive() && this->board.cellAt(coordinates.first, coordinates.second) == ZOMBIE)
+        {
+            this->board.setZombie(coordinates.first, coordinates.second, this->zombies[i].getID());
+        }
     }
 
-    // Initialize the current turn Queue by ID
-    // 0 for Alien, the rest for zombies
-    this->turnQueue.push(0);
+    // Initialize the turn order by ID
+    // 0 for Alien, the rest for zombies, dead ones don't get a turn
+    this->turnOrder.reset(this->numOfZombies);
     for(int i = 0; i < this->numOfZombies; i++)
     {   
-        if (this->zombies[i].isAlive())
-            this->turnQueue.push(zombies[i].getID());
+        if (!this->zombies[i].isAlive())
+            this->turnOrder.remove(zombies[i].getID());
+    }
+
+    this->buildThreatMap();
+    this->buildZombieGrid();
+    this->buildZombieMoves();
+    this->startJournal();
+}
+
+// Start the threat map over from the zombies alive
+void Game::buildThreatMap()
+{
+    this->threatMap.resize(this->rows, this->cols);
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        if (this->zombies[i].isAlive()) this->threatMap.addZombie(this->zombies[i]);
+    }
+}
+
+// Put every living zombie in the zombie grid, once the zombies are set up
+void Game::buildZombieGrid()
+{
+    this->zombieGrid.reset(this->rows, this->cols, this->numOfZombies);
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        if (this->zombies[i].isAlive()) this->zombieGrid.add(i, this->zombies[i].getCoordinates());
+    }
+}
+
+// Work out every zombie's legal moves, once the board and the zombies are set up
+void Game::buildZombieMoves()
+{
+    this->zombieMoves.assign(this->numOfZombies, 0);
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        if (this->zombies[i].isAlive()) this->updateZombieMove(this->zombies[i].getCoordinates());
+    }
+}
+
+// Recompute the legal moves of the zombie on coordinates, if there is one
+// A zombie can move anywhere but off the board, onto the alien or onto another zombie
+void Game::updateZombieMove(pair<int,int> coordinates)
+{
+    if (this->checkCoordinate(coordinates, 4) != 9) return;
+
+    int moves = 0;
+    for(int direction = 0; direction < 4; direction++)
+    {
+        int coordinatesCode = this->checkCoordinate(coordinates, direction);
+        if (coordinatesCode != -1 && coordinatesCode != 8 && coordinatesCode != 9) moves |= 1 << direction;
+    }
+    this->zombieMoves[this->board.getZombieID(coordinates.first, coordinates.second) - 1] = moves;
+}
+
+// Call after the alien or a zombie leaves or enters coordinates, only the zombies next to it can be affected
+void Game::updateZombieMovesAround(pair<int,int> coordinates)
+{
+    static const int moveRow[4] = {-1, 1, 0, 0};
+    static const int moveColumn[4] = {0, 0, -1, 1};
+
+    this->updateZombieMove(coordinates);
+    for(int direction = 0; direction < 4; direction++)
+    {
+        this->updateZombieMove({coordinates.first + moveRow[direction], coordinates.second + moveColumn[direction]});
+    }
+}
+
+// Every board change a Game mutator makes goes through here, so undo can put the cell back
+void Game::setCell(int row, int col, char object)
+{
+    if (!this->checkpoints.empty())
+    {
+        this->discardRedo();
+        JournalEntry entry;
+        entry.kind = 0;
+        entry.index = row * this->cols + col;
+        entry.cell = this->board.get(row, col);
+        entry.occupant = this->board.getZombieID(row, col);
+        this->journal.push_back(entry);
+    }
+    this->board.set(row, col, object);
+}
+
+// Same as setCell, for putting zombie id on the cell
+void Game::setZombieCell(int row, int col, uint32_t id)
+{
+    this->setCell(row, col, Board::zombieSymbol(id));
+    this->board.setZombie(row, col, id);
+}
+
+// Call before moving or hurting zombie index
+void Game::saveZombie(int index)
+{
+    if (this->checkpoints.empty()) return;
+
+    this->discardRedo();
+    JournalEntry entry;
+    entry.kind = 1;
+    entry.index = index;
+    entry.zombie = this->zombies[index];
+    this->journal.push_back(entry);
+}
+
+// Start the journal over, with the game as it is now as the first checkpoint
+void Game::startJournal()
+{
+    this->journal.clear();
+    this->checkpoints.clear();
+    this->currentCheckpoint = 0;
+    if (this->undoLimit > 0) this->checkpoints.push_back(this->makeCheckpoint());
+}
+
+// Drop the checkpoints after the current one, the game has moved on from them
+void Game::discardRedo()
+{
+    if (this->currentCheckpoint == (int)this->checkpoints.size() - 1) return;
+
+    // The entries after the current checkpoint were undone
+    this->journal.resize(this->checkpoints[this->currentCheckpoint].start);
+    this->checkpoints.resize(this->currentCheckpoint + 1);
+}
+
+JournalCheckpoint Game::makeCheckpoint()
+{
+    JournalCheckpoint checkpoint;
+    checkpoint.start = this->journal.size();
+    checkpoint.alien = this->alien;
+    checkpoint.numOfZombiesAlive = this->numOfZombiesAlive;
+    checkpoint.healthLost = this->healthLost;
+    checkpoint.attackGained = this->attackGained;
+    checkpoint.numberOfPlayerTurns = this->numberOfPlayerTurns;
+    checkpoint.gameOver = this->gameOver;
+    checkpoint.turn = this->turnOrder.getPosition();
+    checkpoint.randomEngine = this->randomEngine;
+    return checkpoint;
+}
+
+// Put back everything a checkpoint copies whole, the journal entries are up to the caller
+void Game::restoreCheckpoint(JournalCheckpoint& checkpoint)
+{
+    this->alien = checkpoint.alien;
+    this->numOfZombiesAlive = checkpoint.numOfZombiesAlive;
+    this->healthLost = checkpoint.healthLost;
+    this->attackGained = checkpoint.attackGained;
+    this->numberOfPlayerTurns = checkpoint.numberOfPlayerTurns;
+    this->gameOver = checkpoint.gameOver;
+    this->turnOrder.setPosition(checkpoint.turn);
+    this->randomEngine = checkpoint.randomEngine;
+}
+
+// Only for the last checkpoint, the journal after any other one holds what was undone
+bool Game::hasChangedSince(JournalCheckpoint& checkpoint)
+{
+    if ((int)this->journal.size() > checkpoint.start) return true;
+
+    TurnPosition turn = this->turnOrder.getPosition();
+    return this->alien.getCoordinates() != checkpoint.alien.getCoordinates() ||
+           this->alien.getHealth() != checkpoint.alien.getHealth() ||
+           this->alien.getAttack() != checkpoint.alien.getAttack() ||
+           this->alien.getEnergy() != checkpoint.alien.getEnergy() ||
+           this->numOfZombiesAlive != checkpoint.numOfZombiesAlive ||
+           this->healthLost != checkpoint.healthLost ||
+           this->attackGained != checkpoint.attackGained ||
+           this->numberOfPlayerTurns != checkpoint.numberOfPlayerTurns ||
+           this->gameOver != checkpoint.gameOver ||
+           turn.current != checkpoint.turn.current || turn.currentRemoved != checkpoint.turn.currentRemoved ||
+           this->randomEngine.getPosition() != checkpoint.randomEngine.getPosition();
+}
+
+// Swap the live cell or zombie with the one the entry holds, and bring what is built from them up to date
+// Undo swaps entries newest first, redo swaps them back oldest first
+void Game::swapEntry(JournalEntry& entry)
+{
+    if (entry.kind == 0)
+    {
+        int row = entry.index / this->cols, col = entry.index % this->cols;
+        char cell = this->board.get(row, col);
+        uint32_t occupant = this->board.getZombieID(row, col);
+        if (cellTable[(unsigned char)entry.cell] == ZOMBIE) this->board.setZombie(row, col, entry.occupant);
+        else this->board.set(row, col, entry.cell);
+        entry.cell = cell;
+        entry.occupant = occupant;
+        this->updateZombieMovesAround({row, col});
+        return;
+    }
+
+    Zombie& zombie = this->zombies[entry.index];
+    bool wasAlive = zombie.isAlive();
+    if (wasAlive) this->threatMap.removeZombie(zombie);
+    std::swap(zombie, entry.zombie);
+    if (zombie.isAlive())
+    {
+        this->threatMap.addZombie(zombie);
+        if (this->zombieGrid.contains(entry.index)) this->zombieGrid.move(entry.index, zombie.getCoordinates());
+        else this->zombieGrid.add(entry.index, zombie.getCoordinates());
+        if (!wasAlive) this->turnOrder.restore(entry.index + 1);
+    }
+    else
+    {
+        if (this->zombieGrid.contains(entry.index)) this->zombieGrid.remove(entry.index);
+        if (wasAlive) this->turnOrder.remove(entry.index + 1);
+    }
+}
+
+// How many checkpoints back undo can go, 0 (the default) keeps no journal at all
+// Takes effect from the next newGame or loadGame
+void Game::setUndoLimit(int limit)
+{
+    this->undoLimit = limit;
+}
+
+// Mark the game as it is now as somewhere undo can come back to, call between moves
+// Does nothing if nothing has changed since the current checkpoint
+void Game::checkpoint()
+{
+    if (this->checkpoints.empty() || this->move.mover != -1) return;
+
+    this->discardRedo();
+    if (!this->hasChangedSince(this->checkpoints.back())) return;
+
+    this->checkpoints.push_back(this->makeCheckpoint());
+    this->currentCheckpoint++;
+
+    // Forget the oldest checkpoint once there are too many
+    if ((int)this->checkpoints.size() - 1 > this->undoLimit)
+    {
+        int dropped = this->checkpoints[1].start;
+        this->journal.erase(this->journal.begin(), this->journal.begin() + dropped);
+        this->checkpoints.erase(this->checkpoints.begin());
+        for(int i = 0; i < (int)this->checkpoints.size(); i++)
+        {
+            this->checkpoints[i].start -= dropped;
+        }
+        this->currentCheckpoint--;
+    }
+}
+
+// Roll the game back to the checkpoint before the current one
+// Changes made since the current checkpoint get a checkpoint of their own first, so redo can bring them back
+// Only what changed in between is touched, not the whole board
+// False if there is nothing to undo or a move is being played
+bool Game::undo()
+{
+    if (this->checkpoints.empty() || this->move.mover != -1) return false;
+    if (this->currentCheckpoint == (int)this->checkpoints.size() - 1) this->checkpoint();
+    if (this->currentCheckpoint == 0) return false;
+
+    JournalCheckpoint& target = this->checkpoints[this->currentCheckpoint - 1];
+    for(int i = this->checkpoints[this->currentCheckpoint].start - 1; i >= target.start; i--)
+    {
+        this->swapEntry(this->journal[i]);
+    }
+    this->restoreCheckpoint(target);
+    this->currentCheckpoint--;
+    return true;
+}
+
+// Play forward to the checkpoint after the current one, after an undo
+// False if there is nothing to redo or a move is being played
+bool Game::redo()
+{
+    if (this->checkpoints.empty() || this->move.mover != -1) return false;
+    if (this->currentCheckpoint == (int)this->checkpoints.size() - 1) return false;
+
+    JournalCheckpoint& target = this->checkpoints[this->currentCheckpoint + 1];
+    for(int i = this->checkpoints[this->currentCheckpoint].start; i < target.start; i++)
+    {
+        this->swapEntry(this->journal[i]);
     }
+    this->restoreCheckpoint(target);
+    this->currentCheckpoint++;
+    return true;
 }
 
 vector<int> Game::getAlienStats()
@@ -223,7 +526,6 @@ GameState Game::getGameState()
 
     state.rows = this->rows;
     state.cols = this->cols;
-    state.board.resize(this->rows, vector<char> (this->cols));
     state.board = this->board;
 
     state.alienAttributes.resize(5);
@@ -234,21 +536,31 @@ GameState Game::getGameState()
     state.zombieAttributes = this->getZombieStats();
 
     // To be used by Controller for tracking player stats
-    state.numberOfPlayerTurns = 0; // Set/Tracked by Controller
+    state.numberOfPlayerTurns = this->numberOfPlayerTurns;
     state.healthLost = this->healthLost;
     state.attackGained = this->attackGained;
+    state.randomSeed = this->randomEngine.getSeed();
+    state.randomPosition = this->randomEngine.getPosition();
 
     return state;
 }
 
-// Generates new board with randomized game object and zombie placements 
-void Game::generateNewBoard()
+// What a renderer needs to draw the game, without copying the board or the zombies
+GameView Game::getView()
+{
+    return {this->board, this->alien.getHealth(), this->alien.getAttack(), this->alien.getEnergy(),
+            this->numOfZombies, this->zombies.data(), this->getCurrentTurn()};
+}
+
+// Generates new board with randomized game object and zombie placements
+// zombieCoordinates gets where each zombie was put, by ID - 1
+void Game::generateNewBoard(vector<pair<int,int>>& zombieCoordinates)
 {
     // Total number of empty cells (w/o Alien and Zombies)
     int totalEmptyCell = (this->rows * this->cols) - 1 - this->numOfZombies; 
     /*
     alien        - A
-    zombie       - 1, 2, ..., 9
+    zombie       - 1, 2, ..., 9, Z past 9
 
     rock (10%)   - r
     pod (10%)    - p
@@ -282,35 +594,42 @@ void Game::generateNewBoard()
     }
 
     // Size the board and initialize every cell as ' '
-    this->board.resize(this->rows, vector<char> (this->cols, ' '));
+    this->board.resize(this->rows, this->cols, ' ');
 
     // Set Alien at the center of the board
-    board[this->rows/2][this->cols/2] = 'A';
+    this->board.set(this->rows/2, this->cols/2, 'A');
 
     // Shuffle the coordinates
-    auto rng = std::default_random_engine(time(NULL));
-    std::shuffle(coordinates.begin(), coordinates.end(), rng);
+    std::shuffle(coordinates.begin(), coordinates.end(), this->randomEngine);
+    zombieCoordinates.resize(this->numOfZombies);
 
     
     // Two pointer to assign every objects to shuffled coordinates
     int pointer1 = 0, pointer2 = 0;
     while (pointer1 < totalEntities.size() && pointer2 < coordinates.size())
     {
-        char& selectedCoordinate = this->board[coordinates[pointer2].first][coordinates[pointer2].second]; 
+        char selectedCoordinate; 
         if (totalEntities[pointer1].second)
         {
             selectedCoordinate = totalEntities[pointer1].first; 
 
-            // If it is an arrow cell we random generate a direction
+            // Zombies are placed from the highest ID down
             if (selectedCoordinate == 'Z')
             {
-                selectedCoordinate = totalEntities[pointer1].second + '0';
+                int zombieID = totalEntities[pointer1].second;
+                this->board.setZombie(coordinates[pointer2].first, coordinates[pointer2].second, zombieID);
+                zombieCoordinates[zombieID-1] = coordinates[pointer2];
+                totalEntities[pointer1].second--;
+                pointer2++;
+                continue;
             }
+            // If it is an arrow cell we random generate a direction
             if (selectedCoordinate == '*')
             {
                 vector<char> arrows = {'^', 'v', '>', '<'};
-                selectedCoordinate = arrows[rand() % 4];
+                selectedCoordinate = arrows[this->randomInt(4)];
             }
+            this->board.set(coordinates[pointer2].first, coordinates[pointer2].second, selectedCoordinate);
 
             totalEntities[pointer1].second--;
             pointer2++;
@@ -323,53 +642,28 @@ void Game::generateNewBoard()
 }
 
 // Get Zombie coordinates based off its ID from randomly generated board
+// Living zombies are looked up in the zombie grid, a dead one is no longer on the board and gives {-1, -1}
 std::pair<int, int> Game::getZombieCoordinatesFromBoard(int zombieID)
 {
-    // Convert zombie ID (eg. 1) to char ('1')
-    char zombieInBoard = zombieID + '0';
-
-    // Iterate through board to find coordinates of each zombie on the randomly generated board
-    std::pair<int, int> zombieCoordinates;
-    for(int i = 0; i < this->rows; i++)
-    {
-        for(int j = 0; j < this->cols; j++)
-        {
-            // If the zombie corresponding to the ID is found on the board
-            if (this->board[i][j] == zombieInBoard)
-            {
-                zombieCoordinates.first = i;
-                zombieCoordinates.second = j;
-                return zombieCoordinates;
-            }
-        }
-    }
-
-    // Default
-    return zombieCoordinates;
+    return this->zombieGrid.getPosition(zombieID-1);
 }
 
 
 int Game::getCurrentTurn()
 {
-    while (this->turnQueue.front() != 0 && !this->zombies[this->turnQueue.front()-1].isAlive()){
-        this->turnQueue.pop();
-    }
-    return this->turnQueue.front();
+    return this->turnOrder.getCurrent();
 }
 
 
 void Game::nextTurn()
 {
-    int currentID = this->turnQueue.front();
-    this->turnQueue.pop();
-    if (currentID == 0)
-    {
-        this->turnQueue.push(currentID);
-    }
-    else
-    {
-        if (this->zombies[currentID-1].isAlive()) this->turnQueue.push(currentID);
-    }
+    this->turnOrder.advance();
+}
+
+// Who gets the count turns after the current one, for planning ahead
+void Game::getNextTurns(int count, vector<int>& actors)
+{
+    this->turnOrder.peek(count, actors);
 }
 
 
@@ -381,15 +675,22 @@ void Game::moveZombie(int id, int direction)
     int column = zombieCoordinates.second;
 
     // change zombie to space on the board
-    this->board[row][column] = ' ';
+    this->setCell(row, column, ' ');
 
     // direction: 0 up, 1 down, 2 left, 3 right
     vector<int> moveColumn = {0, 0, -1, 1};
     vector<int> moveRow = {-1, 1, 0, 0};
+    this->threatMap.removeZombie(this->zombies[id-1]);
+    this->saveZombie(id-1);
     this->zombies[id-1].move(moveRow[direction], moveColumn[direction]);
+    this->threatMap.addZombie(this->zombies[id-1]);
+    this->zombieGrid.move(id-1, this->zombies[id-1].getCoordinates());
 
     // put zombie on the new coordinate
-    this->board[row + moveRow[direction]][column + moveColumn[direction]] = id + '0';
+    this->setZombieCell(row + moveRow[direction], column + moveColumn[direction], id);
+
+    this->updateZombieMovesAround(zombieCoordinates);
+    this->updateZombieMovesAround(this->zombies[id-1].getCoordinates());
 }
 
 
@@ -409,14 +710,17 @@ void Game::moveAlien(int direction)
     alien.move(moveRow[direction], moveColumn[direction]);
 
     // change alien to trail on the board
-    board[row][column] = '.';
+    this->setCell(row, column, '.');
 
     // put alien on the new coordinate
-    board[row + moveRow[direction]][column + moveColumn[direction]] = 'A';
+    this->setCell(row + moveRow[direction], column + moveColumn[direction], 'A');
+
+    this->updateZombieMovesAround(alienCoordinates);
+    this->updateZombieMovesAround(this->alien.getCoordinates());
 }
 
 /*
-    Return what is on the coordinate
+    Return what is on the coordinate, see Cell in board.h
 
     invalid = -1
     arrows = 0-3
@@ -426,68 +730,39 @@ void Game::moveAlien(int direction)
     empty space = 7
     alien = 8
     zombie = 9
+    trail = 10
 */
 int Game::checkCoordinate(pair<int,int>& coord, int direction)
 {
     // U D L R S(Stay)
-    vector<int> moveRow = {-1, 1, 0, 0, 0};
-    vector<int> moveColumn = {0, 0, -1, 1, 0};
+    static const int moveRow[5] = {-1, 1, 0, 0, 0};
+    static const int moveColumn[5] = {0, 0, -1, 1, 0};
     int row = coord.first + moveRow[direction];
     int column = coord.second + moveColumn[direction];
 
-    int numberOfRows = this->rows;
-    int numberOfColumns = this->cols;
-
-
-    if (row < 0 || row >= numberOfRows || column < 0 || column >= numberOfColumns)
-    {
-        return -1;
-    }
-
-    switch(this->board[row][column])
-    {
-        case '^':
-            return 0;
-        case 'v':
-            return 1;
-        case '<':
-            return 2;
-        case '>':
-            return 3;
-        case 'h':
-            return 4;
-        case 'p':
-            return 5;
-        case 'r':
-            return 6;
-        case ' ':
-            return 7;
-        case 'A':
-            return 8;
-        case '.':
-            return 10;
-        default:
-            // can only be zombie
-            return 9;
-    }
+    return this->board.checkCell(row, column);
 }
 
 void Game::changeArrowDirection(pair<int,int> arrowCoordinates, int newDirection)
 {
     vector<char> arrows = {'^', 'v', '<', '>'};
-    this->board[arrowCoordinates.first][arrowCoordinates.second] = arrows[newDirection];
+    this->setCell(arrowCoordinates.first, arrowCoordinates.second, arrows[newDirection]);
 }
 
 
 // return if the zombie is alive
 bool Game::attackZombie(pair<int,int> zombieCoordinates)
 {
-    int zombieID = this->board[zombieCoordinates.first][zombieCoordinates.second]-'0';
+    int zombieID = this->board.getZombieID(zombieCoordinates.first, zombieCoordinates.second);
 
+    this->saveZombie(zombieID-1);
     this->zombies[zombieID-1].receiveAttack(this->alien.getAttack());
 
     if (!this->zombies[zombieID-1].isAlive())
     {
+        this->threatMap.removeZombie(this->zombies[zombieID-1]);
+        this->zombieGrid.remove(zombieID-1);
+        this->turnOrder.remove(zombieID);
         this->numOfZombiesAlive--;
         gameOver = !numOfZombiesAlive;
         return true;
@@ -516,8 +791,8 @@ bool Game::attackAlien(int zombieID)
 void Game::clearTrail(pair<int,int> coordinates)
 {
     vector<char> arrows = {'^', 'v', '<', '>'};
-    int rng = rand() % 100;
-    char& cell = this->board[coordinates.first][coordinates.second];
+    int rng = this->randomInt(100);
+    char cell;
     if (rng < 55)
     {
        cell = ' '; 
@@ -541,15 +816,16 @@ void Game::clearTrail(pair<int,int> coordinates)
 
     if (cell == 'a')
     {
-        cell = arrows[rand() % 4];
+        cell = arrows[this->randomInt(4)];
     }
+    this->setCell(coordinates.first, coordinates.second, cell);
 }
 
 void Game::encounterRock(pair<int,int> rockCoordinates)
 {
     vector<char> arrows = {'^', 'v', '<', '>'};
-    int rng = rand() % 90;
-    char& cell = this->board[rockCoordinates.first][rockCoordinates.second];
+    int rng = this->randomInt(90);
+    char cell;
 
     if (rng < 55)
     {
@@ -570,8 +846,9 @@ void Game::encounterRock(pair<int,int> rockCoordinates)
 
     if (cell == 'a')
     {
-        cell = arrows[rand() % 4];
+        cell = arrows[this->randomInt(4)];
     }
+    this->setCell(rockCoordinates.first, rockCoordinates.second, cell);
 }
 
 void Game::encounterHealth()
@@ -585,87 +862,286 @@ void Game::encounterArrow()
     this->attackGained += alien.getAttack();
 }
 
-// Get vector of closest zombies to be used by Pod
-vector<int> Game::getClosestZombies()
+// Phases of the move in progress
+enum MovePhase
 {
-    pair<int,int> alienCoordinates = this->alien.getCoordinates();
-    int minimalDistance = INT_MAX;
-    vector<int> closestZombies;
+    ALIEN_SLIDING,
+    // Alien is next to a zombie and hits it on the next step
+    ALIEN_ATTACKING,
+    ALIEN_REGENERATING,
+    ZOMBIE_STEPPING,
+    // Zombie is next to a rock and breaks it on the next step
+    ZOMBIE_BREAKING_ROCK,
+    ZOMBIE_ATTACKING
+};
+
+// Start moving the alien, the move is played out by stepMove
+// Every alien move is one of the player's turns
+void Game::beginAlienMove(int direction)
+{
+    this->numberOfPlayerTurns++;
+    this->move.mover = 0;
+    this->move.direction = direction;
+    this->move.phase = ALIEN_SLIDING;
+    this->move.trails.clear();
+    this->move.trailIndex = 0;
+    this->move.regenerated.assign(this->rows * this->cols, 0);
+}
 
-    for(int i = 0; i < this->numOfZombies; i++)
+// Start moving zombie id, the move is played out by stepMove, direction -1 passes
+void Game::beginZombieMove(int id, int direction)
+{
+    this->move.mover = id;
+    this->move.direction = direction;
+    this->move.phase = ZOMBIE_STEPPING;
+}
+
+// Play the next step of the move in progress, adding what happened to events
+// Return false once the move is over, the step that ends it may still add events
+bool Game::stepMove(vector<GameEvent>& events)
+{
+    if (this->move.mover == -1) return false;
+
+    if (this->move.mover == 0)
     {
-        if (!this->zombies[i].isAlive()) continue;
+        this->stepAlienMove(events);
+    }
+    else
+    {
+        this->stepZombieMove(events);
+    }
+    return this->move.mover != -1;
+}
 
-        pair<int,int> zombieCoordinates = this->zombies[i].getCoordinates();
-        
-        // Pythagorean theorem for distance
-        // Without square rooting, to avoid dealing with floating point value
-        int distanceBetween = 
-            (alienCoordinates.first-zombieCoordinates.first) * (alienCoordinates.first-zombieCoordinates.first)
-            +
-            (alienCoordinates.second-zombieCoordinates.second) * (alienCoordinates.second-zombieCoordinates.second)
-        ;
+// Play a whole alien move without stopping, for when nothing is shown
+void Game::applyAlienMove(int direction, vector<GameEvent>& events)
+{
+    this->beginAlienMove(direction);
+    while (this->stepMove(events));
+}
+
+// Play a whole zombie move without stopping, for when nothing is shown
+void Game::applyZombieMove(int id, int direction, vector<GameEvent>& events)
+{
+    this->beginZombieMove(id, direction);
+    while (this->stepMove(events));
+}
+
+// Random direction zombie id can move in, anything but off the board, the alien or another zombie
+// Every legal direction is equally likely and takes one draw, -1 if the zombie is boxed in and has to pass
+int Game::getRandomZombieDirection(int id)
+{
+    int moves = this->zombieMoves[id-1];
+    if (moves == 0) return -1;
 
-        if (distanceBetween < minimalDistance)
+    // Drop the lowest set bits until the chosen one is lowest
+    for(int skip = this->randomInt(__builtin_popcount(moves)); skip > 0; skip--)
+    {
+        moves &= moves - 1;
+    }
+    return __builtin_ctz(moves);
+}
+
+// Directions zombie id can move in, bit d for direction d (U, D, L, R)
+int Game::getZombieMoves(int id)
+{
+    return this->zombieMoves[id-1];
+}
+
+// One cell of the alien's slide, or one attack on a zombie, or one trail regenerating once the slide is over
+void Game::stepAlienMove(vector<GameEvent>& events)
+{
+    // U, D, L, R
+    static const int moveRow[4] = {-1, 1, 0, 0};
+    static const int moveColumn[4] = {0, 0, -1, 1};
+
+    MoveProgress& move = this->move;
+    pair<int,int> currentCoordinates = this->alien.getCoordinates();
+    pair<int,int> nextCoordinates = {currentCoordinates.first + moveRow[move.direction], currentCoordinates.second + moveColumn[move.direction]};
+
+    if (move.phase == ALIEN_SLIDING)
+    {
+        /*
+            invalid = -1
+            arrows = 0-3
+            health = 4
+            pod = 5
+            rock = 6
+            empty space = 7
+            alien = 8
+            zombie = 9
+            trail = 10
+        */
+        int result = this->checkCoordinate(currentCoordinates, move.direction);
+        if (result >= 0 && result <= 3)
         {
-            minimalDistance = distanceBetween;
-            closestZombies.clear();           
+            this->encounterArrow();
+            move.trails.push_back(currentCoordinates);
+            this->moveAlien(move.direction);
+            move.direction = result;
+            events.push_back({ALIEN_ARROW, 0, 20, nextCoordinates});
         }
-
-        if (distanceBetween <= minimalDistance)
+        else if (result == 4)
+        {
+            int health = this->alien.getHealth();
+            this->encounterHealth();
+            move.trails.push_back(currentCoordinates);
+            this->moveAlien(move.direction);
+            events.push_back({ALIEN_HEALTH, 0, this->alien.getHealth() - health, nextCoordinates});
+        }
+        else if (result == 5)
         {
-            closestZombies.push_back(i);
+            int zombieAttacked = this->encounterPod();
+            move.trails.push_back(currentCoordinates);
+            this->moveAlien(move.direction);
+            events.push_back({ALIEN_POD, zombieAttacked, 10, nextCoordinates});
+            if (this->gameOver) move.phase = ALIEN_REGENERATING;
+        }
+        else if (result == 6)
+        {
+            this->encounterRock(nextCoordinates);
+            events.push_back({ALIEN_ROCK, 0, 0, nextCoordinates});
+            move.phase = ALIEN_REGENERATING;
+        }
+        else if (result == 7 || result == 10)
+        {
+            move.trails.push_back(currentCoordinates);
+            this->moveAlien(move.direction);
+            events.push_back({ALIEN_MOVED, 0, 0, nextCoordinates});
+        }
+        else if (result == 9)
+        {
+            events.push_back({ALIEN_ZOMBIE_AHEAD, this->getZombieIDAt(nextCoordinates), 0, nextCoordinates});
+            move.phase = ALIEN_ATTACKING;
+        }
+        else
+        {
+            events.push_back({ALIEN_WALL, 0, 0, currentCoordinates});
+            move.phase = ALIEN_REGENERATING;
+        }
+    }
+    else if (move.phase == ALIEN_ATTACKING)
+    {
+        int zombieID = this->getZombieIDAt(nextCoordinates);
+        int attack = this->alien.getAttack();
+        if (this->attackZombie(nextCoordinates))
+        {
+            move.trails.push_back(currentCoordinates);
+            this->moveAlien(move.direction);
+            events.push_back({ALIEN_ZOMBIE_KILLED, zombieID, attack, nextCoordinates});
+            move.phase = this->gameOver ? ALIEN_REGENERATING : ALIEN_SLIDING;
+        }
+        else
+        {
+            events.push_back({ALIEN_ZOMBIE_SURVIVED, zombieID, attack, nextCoordinates});
+            move.phase = ALIEN_REGENERATING;
         }
     }
+    else
+    {
+        // One trail per step, except the cell the alien stopped on and cells already regenerated
+        while (move.trailIndex < (int)move.trails.size())
+        {
+            pair<int,int> trail = move.trails[move.trailIndex++];
+            int cell = trail.first * this->cols + trail.second;
+            if (trail == this->alien.getCoordinates() || move.regenerated[cell]) continue;
+
+            move.regenerated[cell] = 1;
+            this->clearTrail(trail);
+            events.push_back({TRAIL_REGENERATED, 0, 0, trail});
+            return;
+        }
 
-    return closestZombies;
+        // Attack from arrows only lasts for the move it was gained in
+        this->alien.incAttack(-this->alien.getAttack());
+        move.mover = -1;
+    }
 }
 
-// Checks for closest zombie based off conditions, used by hint
-vector<int> Game::getClosestZombiesFromState(pair<int,int>& coord, vector<int>& zombiesHealth)
+// Zombie moves one cell or breaks the rock in its way, then attacks the alien if it is in range
+void Game::stepZombieMove(vector<GameEvent>& events)
 {
-    int minimalDistance = INT_MAX;
-    vector<int> closestZombies;
+    // U, D, L, R
+    static const int moveRow[4] = {-1, 1, 0, 0};
+    static const int moveColumn[4] = {0, 0, -1, 1};
 
-    for(int i = 0; i < this->numOfZombies; i++)
-    {
-        if (zombiesHealth[i] <= 0) continue;
+    MoveProgress& move = this->move;
+    int id = move.mover;
+    pair<int,int> currentCoordinates = this->zombies[id-1].getCoordinates();
 
-        pair<int,int> zombieCoordinates = this->zombies[i].getCoordinates();
-        
-        // Pythagorean theorem for distance
-        // Without square rooting, to avoid dealing with floating point value
-        int distanceBetween = 
-            (coord.first-zombieCoordinates.first) * (coord.first-zombieCoordinates.first)
-            +
-            (coord.second-zombieCoordinates.second) * (coord.second-zombieCoordinates.second)
-        ;
+    // A boxed-in zombie stays where it is, it still attacks if the alien is in range
+    if (move.phase == ZOMBIE_STEPPING && move.direction == -1)
+    {
+        events.push_back({ZOMBIE_PASSED, id, 0, currentCoordinates});
+        move.phase = ZOMBIE_ATTACKING;
+        return;
+    }
 
-        if (distanceBetween < minimalDistance)
+    if (move.phase == ZOMBIE_STEPPING)
+    {
+        pair<int,int> nextCoordinates = {currentCoordinates.first + moveRow[move.direction], currentCoordinates.second + moveColumn[move.direction]};
+        if (this->checkCoordinate(currentCoordinates, move.direction) == 6)
         {
-            minimalDistance = distanceBetween;
-            closestZombies.clear();           
+            events.push_back({ZOMBIE_ROCK, id, 0, nextCoordinates});
+            move.phase = ZOMBIE_BREAKING_ROCK;
         }
-
-        if (distanceBetween <= minimalDistance)
+        else
         {
-            closestZombies.push_back(i);
+            this->moveZombie(id, move.direction);
+            events.push_back({ZOMBIE_MOVED, id, 0, nextCoordinates});
+            move.phase = ZOMBIE_ATTACKING;
         }
+        return;
     }
 
+    if (move.phase == ZOMBIE_BREAKING_ROCK)
+    {
+        this->encounterRock({currentCoordinates.first + moveRow[move.direction], currentCoordinates.second + moveColumn[move.direction]});
+    }
+
+    bool attacked = this->attackAlien(id);
+    events.push_back({ZOMBIE_ATTACK, id, attacked ? this->zombies[id-1].getAttack() : 0, this->alien.getCoordinates()});
+    move.mover = -1;
+}
+
+// Get vector of closest zombies to be used by Pod, in ID order
+// Distance is squared (Pythagorean theorem without the square root), only living zombies are in the zombie grid
+vector<int> Game::getClosestZombies()
+{
+    pair<int,int> alienCoordinates = this->alien.getCoordinates();
+    auto skipNone = [](int) { return false; };
+    vector<int> closestZombies;
+
+    int minimalDistance = this->zombieGrid.closestDistance(alienCoordinates, skipNone);
+    if (minimalDistance != INT_MAX)
+    {
+        this->zombieGrid.within(alienCoordinates, minimalDistance, skipNone, closestZombies);
+    }
     return closestZombies;
 }
 
+// Squared distance to the closest zombie alive in the search state, INT_MAX if there is none, used by hint
+int Game::getClosestDistanceFromState(pair<int,int>& coord, SearchContext& context)
+{
+    // Zombies don't move during the slide, so the live zombie grid is where they are in the search too
+    return this->zombieGrid.closestDistance(coord, [&context](int index) { return context.zombiesHealth[index] <= 0; });
+}
+
 int Game::encounterPod()
 {
     vector<int> closestZombies = this->getClosestZombies();
-    int randomZombieSelected = closestZombies[rand() % closestZombies.size()];
+    int randomZombieSelected = closestZombies[this->randomInt(closestZombies.size())];
+    this->saveZombie(randomZombieSelected);
     this->zombies[randomZombieSelected].receiveAttack(10);
 
     if (!this->zombies[randomZombieSelected].isAlive())
     {
         pair<int,int> zombieCoordinates = this->zombies[randomZombieSelected].getCoordinates();
-        this->board[zombieCoordinates.first][zombieCoordinates.second] = ' ';
+        this->setCell(zombieCoordinates.first, zombieCoordinates.second, ' ');
+        this->threatMap.removeZombie(this->zombies[randomZombieSelected]);
+        this->zombieGrid.remove(randomZombieSelected);
+        this->turnOrder.remove(randomZombieSelected+1);
+        this->updateZombieMovesAround(zombieCoordinates);
         this->numOfZombiesAlive--;
         this->gameOver = !this->numOfZombiesAlive;
     }
@@ -677,46 +1153,50 @@ int Game::encounterPod()
 
 // moveDetails = {win/lose, netHealth, zombieSlained, attackDealt, attackGain, isARock}
 // Every ID of zombies is 0-indexed in this function
-void Game::searchGoodMove(pair<int,int> coord, vector<int>& moveDetails, vector<int>& zombiesHealth, int energyLeft, int initDirection, int curDirection, vector<vector<int>>& arrowsData, vector<int>& goodMoveDetails, int& goodDirection, vector<vector<int>>& goodArrowsData)
+// The search only reads and writes context, never the live board, so several can run at once
+// stateHash covers the arrows cleared so far and the zombies health, see Zobrist in transposition_table.h
+// The best leaf of this subtree is merged into goodMoveDetails, a later leaf wins a tie
+// Nothing in here touches the heap, the serial hint runs allocation-free once warmed up
+void Game::searchGoodMove(pair<int,int> coord, MoveDetails& moveDetails, SearchContext& context, int energyLeft, int curDirection, uint64_t stateHash, ArrowStack& arrowsData, MoveDetails& goodMoveDetails, ArrowStack& goodArrowsData)
 {
     // U, D, L, R
-    vector<int> rowMove = {-1, 1, 0, 0};
-    vector<int> colMove = {0, 0, -1, 1};
+    static const int rowMove[4] = {-1, 1, 0, 0};
+    static const int colMove[4] = {0, 0, -1, 1};
+
+    Board& board = context.board;
+    vector<int>& zombiesHealth = context.zombiesHealth;
+    context.stats.nodesVisited++;
 
-    // First Move, Go at every direction
-    if (initDirection == -1)
+    if (context.stop != nullptr)
     {
-        for(int i = 0; i < 4; i++)
+        // Reading the clock costs more than a search step, so only check it every 1024 nodes
+        if ((context.stats.nodesVisited & 1023) == 0 && std::chrono::steady_clock::now() >= context.deadline)
         {
-            if (this->checkCoordinate(coord, i) == -1) continue;
-            searchGoodMove(coord, moveDetails, zombiesHealth, energyLeft, i, i,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+            *context.stop = true;
         }
-        return;
+        if (*context.stop) return;
     }
 
-    int cellID = this->checkCoordinate(coord, curDirection);
+    int nextRow = coord.first + rowMove[curDirection];
+    int nextCol = coord.second + colMove[curDirection];
+    int cellID = board.checkCell(nextRow, nextCol);
+
+    // Remember what was read, for the hint cache
+    if (context.dependencies != nullptr && cellID != -1)
+    {
+        context.dependencies->cellsRead[nextRow * this->cols + nextCol] = 1;
+    }
 
     if (cellID == -1 || cellID == 6)
     {
-        int healthLost = 0;
-        for(int i = 0; i < this->numOfZombies; i++)
-        {
-            // pair<int,int> zombieCoordinate = this->zombies[i].getCoordinates();
-            // If zombie is alive
-            if (zombiesHealth[i] > 0)
-            {
-                healthLost += this->zombies[i].isInRange(coord) * this->zombies[i].getAttack();
-            }
-        }
+        this->recordLeaf(context, coord);
+
+        int healthLost = this->getDamageAt(coord, context);
         // Decrease net health
         moveDetails[1] -= healthLost;
 
         // Search if there is any zombie that is alive
-        bool foundAlive = 0;
-        for(int i = 0; i < this->numOfZombies; i++)
-        {
-            if (zombiesHealth[i] > 0) foundAlive = 1;
-        }
+        bool foundAlive = this->numOfZombiesAlive > (int)context.killedZombies.size();
 
         // If no zombie is alive, we won
         if (!foundAlive)
@@ -729,7 +1209,6 @@ void Game::searchGoodMove(pair<int,int> coord, vector<int>& moveDetails, vector<
         if (moveDetails >= goodMoveDetails)
         {
             goodMoveDetails = moveDetails;
-            goodDirection = initDirection;
             goodArrowsData = arrowsData; 
         }
 
@@ -745,9 +1224,14 @@ void Game::searchGoodMove(pair<int,int> coord, vector<int>& moveDetails, vector<
     }
     else if (cellID == 9)
     {
-        int zombieID = this->board[coord.first+rowMove[curDirection]][coord.second+colMove[curDirection]]-'0'-1;
+        int zombieID = board.getZombieID(nextRow, nextCol) - 1;
         if (zombiesHealth[zombieID] > 0)
         {
+            if (context.dependencies != nullptr)
+            {
+                context.dependencies->zombiesUsed[zombieID] = 1;
+            }
+
             int zombieHealth = zombiesHealth[zombieID];
             // If Alien can kill the zombie
             if (this->alien.getAttack() + moveDetails[3] > zombiesHealth[zombieID])
@@ -758,11 +1242,14 @@ void Game::searchGoodMove(pair<int,int> coord, vector<int>& moveDetails, vector<
                 moveDetails[3] +=  zombieHealth;
                 zombiesHealth[zombieID] = 0;
                 moveDetails[2]++;
-                this->board[coord.first+rowMove[curDirection]][coord.second+colMove[curDirection]] = ' ';
+                context.killedZombies.push_back(zombieID);
+                board.set(nextRow, nextCol, ' ');
+                uint64_t killedHash = stateHash ^ Zobrist::zombieHealthKey(zombieID, zombieHealth) ^ Zobrist::zombieHealthKey(zombieID, 0);
 
-                searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft, initDirection, curDirection,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+                searchGoodMove({nextRow, nextCol}, moveDetails, context, energyLeft, curDirection, killedHash, arrowsData, goodMoveDetails, goodArrowsData);
 
-                this->board[coord.first+rowMove[curDirection]][coord.second+colMove[curDirection]] = zombieID + 1 + '0';
+                board.setZombie(nextRow, nextCol, zombieID + 1);
+                context.killedZombies.pop_back();
                 // Revert the change
                 moveDetails[3] -=  zombieHealth;
                 zombiesHealth[zombieID] = zombieHealth;
@@ -774,24 +1261,19 @@ void Game::searchGoodMove(pair<int,int> coord, vector<int>& moveDetails, vector<
                 // Decrease Zombie Health
                 moveDetails[3] +=  this->alien.getAttack() + moveDetails[4];
                 zombiesHealth[zombieID] -= this->alien.getAttack() + moveDetails[4];
+                this->recordLeaf(context, coord);
 
-                int healthLost = 0;
-                for(int i = 0; i < this->numOfZombies; i++)
-                {
-                    // pair<int,int> zombieCoordinate = this->zombies[i].getCoordinates();
-                    // If zombie is alive
-                    if (zombiesHealth[i] > 0)
-                    {
-                        healthLost += this->zombies[i].isInRange(coord) * this->zombies[i].getAttack();
-                    }
-                }
+                // The hit can still bring the zombie to 0 health, then it deals no damage here
+                bool hitToDeath = zombiesHealth[zombieID] <= 0;
+                if (hitToDeath) context.killedZombies.push_back(zombieID);
+                int healthLost = this->getDamageAt(coord, context);
+                if (hitToDeath) context.killedZombies.pop_back();
                 // Decrease net health
                 moveDetails[1] -= healthLost;
 
                 if (moveDetails >= goodMoveDetails)
                 {
                     goodMoveDetails = moveDetails;
-                    goodDirection = initDirection;
                     goodArrowsData = arrowsData; 
                 }
 
@@ -803,97 +1285,469 @@ void Game::searchGoodMove(pair<int,int> coord, vector<int>& moveDetails, vector<
         }
         else
         {
-            searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft, initDirection, curDirection,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+            searchGoodMove({nextRow, nextCol}, moveDetails, context, energyLeft, curDirection, stateHash, arrowsData, goodMoveDetails, goodArrowsData);
         }
     }
     else if (cellID >= 0 && cellID <= 3)
     {
-        vector<char> arrows = {'^', 'v', '<', '>'};
+        // Different rotations lead back into the same arrows, so arrow cells are the ones cached
+        uint64_t key = Zobrist::nodeKey(stateHash, coord.first, coord.second, curDirection, energyLeft, moveDetails[3], moveDetails[4]);
+        TranspositionEntry* entry = context.table->probe(key);
+        if (entry != nullptr)
+        {
+            context.stats.ttHits++;
+            MoveDetails cachedDetails;
+            for(int i = 0; i < 6; i++)
+            {
+                cachedDetails[i] = moveDetails[i] + entry->bestDetails[i];
+            }
+            if (cachedDetails >= goodMoveDetails)
+            {
+                goodMoveDetails = cachedDetails;
+                goodArrowsData = arrowsData;
+                for(int i = 0; i < entry->numOfArrows; i++)
+                {
+                    goodArrowsData.push(entry->arrows[i].row, entry->arrows[i].col, entry->arrows[i].direction);
+                }
+            }
+            return;
+        }
+
+        // Best of this subtree alone, so it can be stored
+        MoveDetails subtreeDetails;
+        subtreeDetails.fill(-INT_MAX);
+        ArrowStack subtreeArrows;
+        uint64_t clearedHash = stateHash ^ Zobrist::clearedCellKey(nextRow * this->cols + nextCol);
+
+        static const char arrows[4] = {'^', 'v', '<', '>'};
         // Gain 20 attack
         moveDetails[4] += 20;
-        if (energyLeft)
+        board.set(nextRow, nextCol, ' ');
+
+        // Near the root of a parallel hint, every way out of the arrow becomes its own task
+        if (context.pool != nullptr && context.arrowDepth < context.forkDepth)
         {
+            vector<HintTask> branches;
             for(int i = 0; i < 4; i++)
             {
                 // Original arrow doesn't need energy to rotate
-                if (cellID == i) continue;
+                if (cellID == i || !energyLeft) continue;
 
-                // Add to arrow change 
-                arrowsData.push_back({coord.first+rowMove[curDirection], coord.second+colMove[curDirection], i});
-                this->board[coord.first+rowMove[curDirection]][coord.second+colMove[curDirection]] = ' ';
+                arrowsData.push(nextRow, nextCol, i);
+                branches.push_back(makeHintTask(context, {nextRow, nextCol}, moveDetails, energyLeft-1, i, clearedHash, arrowsData));
+                arrowsData.pop();
+            }
+            branches.push_back(makeHintTask(context, {nextRow, nextCol}, moveDetails, energyLeft, cellID, clearedHash, arrowsData));
 
-                searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft-1, initDirection, i,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
-                // Revert the change
-                arrowsData.pop_back();
-                this->board[coord.first+rowMove[curDirection]][coord.second+colMove[curDirection]] = arrows[cellID];
+            this->forkSearch(branches, context.pool);
+            for(int i = 0; i < (int)branches.size(); i++)
+            {
+                context.stats.nodesVisited += branches[i].context.stats.nodesVisited;
+                context.stats.ttHits += branches[i].context.stats.ttHits;
+                context.stats.ttStores += branches[i].context.stats.ttStores;
+                context.stats.cacheHits += branches[i].context.stats.cacheHits;
+                if (branches[i].bestDetails >= subtreeDetails)
+                {
+                    subtreeDetails = branches[i].bestDetails;
+                    subtreeArrows = branches[i].bestArrows;
+                }
             }
         }
-        this->board[coord.first+rowMove[curDirection]][coord.second+colMove[curDirection]] = ' ';
+        else
+        {
+            if (energyLeft)
+            {
+                for(int i = 0; i < 4; i++)
+                {
+                    // Original arrow doesn't need energy to rotate
+                    if (cellID == i) continue;
+
+                    // Add to arrow change 
+                    arrowsData.push(nextRow, nextCol, i);
+                    searchGoodMove({nextRow, nextCol}, moveDetails, context, energyLeft-1, i, clearedHash, arrowsData, subtreeDetails, subtreeArrows);
+                    // Revert the change
+                    arrowsData.pop();
+                }
+            }
 
-        searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft, initDirection, cellID,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+            searchGoodMove({nextRow, nextCol}, moveDetails, context, energyLeft, cellID, clearedHash, arrowsData, subtreeDetails, subtreeArrows);
+        }
 
-        this->board[coord.first+rowMove[curDirection]][coord.second+colMove[curDirection]] = arrows[cellID];
+        board.set(nextRow, nextCol, arrows[cellID]);
         //Revert the change
         moveDetails[4] -= 20;
+
+        // Store relative to this node, the arrows before it belong to the caller's path
+        // A subtree cut off by the deadline is not finished, so it is not stored
+        int numOfArrows = subtreeArrows.size - arrowsData.size;
+        bool stopped = context.stop != nullptr && *context.stop;
+        if (!stopped)
+        {
+            TranspositionEntry& slot = context.table->slot(key);
+            for(int i = 0; i < 6; i++)
+            {
+                slot.bestDetails[i] = subtreeDetails[i] - moveDetails[i];
+            }
+            for(int i = 0; i < numOfArrows; i++)
+            {
+                slot.arrows[i] = subtreeArrows.changes[arrowsData.size + i];
+            }
+            slot.numOfArrows = numOfArrows;
+            context.stats.ttStores++;
+        }
+
+        if (subtreeDetails >= goodMoveDetails)
+        {
+            goodMoveDetails = subtreeDetails;
+            goodArrowsData = subtreeArrows;
+        }
     }
     else if (cellID == 4)
     {
         int healthGain = std::min(200-(this->alien.getHealth()),20);
         moveDetails[1] += healthGain;
-        searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft, initDirection, curDirection,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+        searchGoodMove({nextRow, nextCol}, moveDetails, context, energyLeft, curDirection, stateHash, arrowsData, goodMoveDetails, goodArrowsData);
         moveDetails[1] -= healthGain;
     }
     else if (cellID == 5)
     {
+        if (context.dependencies != nullptr)
+        {
+            context.dependencies->usedPod = true;
+        }
 
-        vector<int> closestZombies = this->getClosestZombiesFromState(coord, zombiesHealth);
-        
-        if (closestZombies.size() == 0)
+        int closestDistance = this->getClosestDistanceFromState(coord, context);
+        if (closestDistance == INT_MAX)
         {
-            searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft, initDirection, curDirection,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
-        }else
+            searchGoodMove({nextRow, nextCol}, moveDetails, context, energyLeft, curDirection, stateHash, arrowsData, goodMoveDetails, goodArrowsData);
+        }
+        else
         {
-            int randomZombieSelected = closestZombies[rand() % closestZombies.size()];
-            pair<int,int> zombieCoord = this->getZombieCoordinatesFromBoard(randomZombieSelected+1);
-            int zombieHealth = zombiesHealth[randomZombieSelected];
+            // The pod hits one of the closest zombies at random, so plan for the worst of them
+            MoveDetails worstDetails;
+            ArrowStack worstArrows;
+            bool foundTarget = false;
+            // Deeper pods push their own targets after these and take them off again before returning
+            int firstTarget = context.podTargets.size();
+            this->zombieGrid.within(coord, closestDistance, [&zombiesHealth](int index) { return zombiesHealth[index] <= 0; }, context.podTargets);
+            int lastTarget = context.podTargets.size();
+            for(int t = firstTarget; t < lastTarget; t++)
+            {
+                int i = context.podTargets[t];
+                MoveDetails targetDetails;
+                targetDetails.fill(-INT_MAX);
+                ArrowStack targetArrows;
+                this->searchPodTarget(i, {nextRow, nextCol}, moveDetails, context, energyLeft, curDirection, stateHash, arrowsData, targetDetails, targetArrows);
 
-            if (zombieHealth <= 10)
+                if (!foundTarget || targetDetails < worstDetails)
+                {
+                    worstDetails = targetDetails;
+                    worstArrows = targetArrows;
+                }
+                foundTarget = true;
+            }
+            context.podTargets.resize(firstTarget);
+
+            // A target cut off by the deadline before its first leaf leaves nothing to compare
+            if (worstDetails[0] != -INT_MAX && worstDetails >= goodMoveDetails)
             {
-                // Increase attack dealt
-                // Set zombie health to 0
-                // Replace the cell with a space
+                goodMoveDetails = worstDetails;
+                goodArrowsData = worstArrows;
+            }
+        }
+    }
+    else{
+        // If empty space, just keep moving, straight past every empty cell in a row
+        int run = 1;
+        if (cellID == 7 || cellID == 10)
+        {
+            run = board.openRun(coord.first, coord.second, curDirection);
+            for(int i = 2; i <= run && context.dependencies != nullptr; i++)
+            {
+                context.dependencies->cellsRead[(coord.first + i * rowMove[curDirection]) * this->cols + coord.second + i * colMove[curDirection]] = 1;
+            }
+        }
+        searchGoodMove({coord.first + run * rowMove[curDirection], coord.second + run * colMove[curDirection]}, moveDetails, context, energyLeft, curDirection, stateHash, arrowsData, goodMoveDetails, goodArrowsData);
+    }
+}
 
-                moveDetails[3] += zombieHealth;
-                zombiesHealth[randomZombieSelected] = 0;
-                this->board[zombieCoord.first][zombieCoord.second] = ' ';
+// Damage the zombies alive in the search state deal to the alien at coord
+// The threat map has every zombie alive in the game, so only the ones killed along the slide are taken back out
+int Game::getDamageAt(pair<int,int>& coord, SearchContext& context)
+{
+    int damage = this->threatMap.get(coord.first, coord.second);
+    for(int i = 0; i < (int)context.killedZombies.size(); i++)
+    {
+        Zombie& zombie = this->zombies[context.killedZombies[i]];
+        if (zombie.isInRange(coord)) damage -= zombie.getAttack();
+    }
+    return damage;
+}
 
-                searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft, initDirection, curDirection,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+// Carry on the search from coord after a pod hit zombie target (0-indexed)
+void Game::searchPodTarget(int target, pair<int,int> coord, MoveDetails& moveDetails, SearchContext& context, int energyLeft, int curDirection, uint64_t stateHash, ArrowStack& arrowsData, MoveDetails& goodMoveDetails, ArrowStack& goodArrowsData)
+{
+    vector<int>& zombiesHealth = context.zombiesHealth;
+    pair<int,int> zombieCoord = context.zombiesCoordinates[target];
+    int zombieHealth = zombiesHealth[target];
 
-                // Revert the change
-                this->board[zombieCoord.first][zombieCoord.second] = randomZombieSelected+1+'0';
-                zombiesHealth[randomZombieSelected] = zombieHealth;
-                moveDetails[3] -= zombieHealth;
+    if (zombieHealth <= 10)
+    {
+        // Increase attack dealt
+        // Set zombie health to 0
+        // Replace the cell with a space
+        moveDetails[3] += zombieHealth;
+        zombiesHealth[target] = 0;
+        context.killedZombies.push_back(target);
+        context.board.set(zombieCoord.first, zombieCoord.second, ' ');
+        uint64_t podHash = stateHash ^ Zobrist::zombieHealthKey(target, zombieHealth) ^ Zobrist::zombieHealthKey(target, 0);
 
-            }
-            else
+        searchGoodMove(coord, moveDetails, context, energyLeft, curDirection, podHash, arrowsData, goodMoveDetails, goodArrowsData);
+
+        // Revert the change
+        context.board.setZombie(zombieCoord.first, zombieCoord.second, target + 1);
+        context.killedZombies.pop_back();
+        zombiesHealth[target] = zombieHealth;
+        moveDetails[3] -= zombieHealth;
+    }
+    else
+    {
+        // Increase attack dealt
+        // Decreae zombie health
+        moveDetails[3] += 10;
+        zombiesHealth[target] -= 10;
+        uint64_t podHash = stateHash ^ Zobrist::zombieHealthKey(target, zombieHealth) ^ Zobrist::zombieHealthKey(target, zombieHealth - 10);
+
+        searchGoodMove(coord, moveDetails, context, energyLeft, curDirection, podHash, arrowsData, goodMoveDetails, goodArrowsData);
+
+        // Revert the change
+        zombiesHealth[target] += 10;
+        moveDetails[3] -= 10;
+    }
+}
+
+// Copy the scratch state for a branch that may run on another worker
+HintTask Game::makeHintTask(SearchContext& context, pair<int,int> coord, MoveDetails& moveDetails, int energyLeft, int direction, uint64_t stateHash, ArrowStack& arrowsData)
+{
+    HintTask task;
+    task.context = context;
+    task.context.stats = {0, 0, 0, 0};
+    task.context.arrowDepth = context.arrowDepth + 1;
+    task.coord = coord;
+    task.moveDetails = moveDetails;
+    task.energyLeft = energyLeft;
+    task.direction = direction;
+    task.stateHash = stateHash;
+    task.arrowsData = arrowsData;
+    task.bestDetails.fill(-INT_MAX);
+    return task;
+}
+
+// Run every task on the pool and wait for all of them
+// Each worker caches into its own table, so no locking is needed inside the search
+void Game::forkSearch(vector<HintTask>& tasks, WorkStealingPool* pool)
+{
+    TaskGroup group;
+    for(int i = 0; i < (int)tasks.size(); i++)
+    {
+        HintTask* task = &tasks[i];
+        pool->spawn(group, [this, task, pool]()
+        {
+            task->context.table = &this->workerTables[pool->currentWorker()];
+            this->searchGoodMove(task->coord, task->moveDetails, task->context, task->energyLeft, task->direction, task->stateHash, task->arrowsData, task->bestDetails, task->bestArrows);
+        });
+    }
+    pool->wait(group);
+}
+
+// Fill context with a copy of the live game for a new hint search
+void Game::prepareSearchContext(SearchContext& context, TranspositionTable* table)
+{
+    context.board = this->board;
+    context.zombiesHealth.resize(this->numOfZombies);
+    context.zombiesCoordinates.resize(this->numOfZombies);
+    context.stateHash = 0;
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        context.zombiesHealth[i] = this->zombies[i].getHealth();
+        context.zombiesCoordinates[i] = this->zombies[i].getCoordinates();
+        context.stateHash ^= Zobrist::zombieHealthKey(i, context.zombiesHealth[i]);
+    }
+    context.table = table;
+    context.stats = {0, 0, 0, 0};
+    context.pool = nullptr;
+    context.forkDepth = 0;
+    context.arrowDepth = 0;
+    context.stop = nullptr;
+    context.dependencies = nullptr;
+    context.cache = nullptr;
+    context.killedZombies.clear();
+    context.killedZombies.reserve(this->numOfZombies);
+    context.podTargets.clear();
+    context.podTargets.reserve(this->numOfZombies);
+
+    // Cached subtrees depend on the board, nothing carries over from the last hint
+    table->prepare(14);
+}
+
+// Search every first direction with at most energyLeft arrow rotations
+// Directions are merged in order, so ties go to the later direction like they always have
+// Return the direction to go, -1 if no slide was finished
+int Game::searchRoots(SearchContext& context, int energyLeft, MoveDetails& goodMoveDetails, ArrowStack& goodArrowsData)
+{
+    MoveDetails moveDetails {};
+    ArrowStack arrowsData;
+    int goodDirection = -1;
+    pair<int,int> alienCoordinates = this->alien.getCoordinates();
+
+    vector<HintTask> directions;
+    for(int i = 0; i < 4; i++)
+    {
+        if (this->checkCoordinate(alienCoordinates, i) == -1) continue;
+
+        if (context.cache != nullptr && context.cache->valid[i])
+        {
+            // Nothing this direction depends on changed since it was searched
+            context.stats.cacheHits++;
+            goodDirection = this->mergeDirection(i, context.cache->bestDetails[i], context.cache->bestArrows[i], goodDirection, goodMoveDetails, goodArrowsData);
+        }
+        else if (context.pool == nullptr)
+        {
+            // Serial search keeps working in the caller's context
+            MoveDetails directionDetails;
+            directionDetails.fill(-INT_MAX);
+            ArrowStack directionArrows;
+            uint64_t rootHash = context.stateHash;
+            if (context.cache != nullptr)
             {
-                // Increase attack dealt
-                // Decreae zombie health
-                moveDetails[3] += 10;
-                zombiesHealth[randomZombieSelected] -= 10;
+                // A cached direction must only depend on what it read itself, so directions don't share subtrees
+                context.dependencies = &context.cache->dependencies[i];
+                rootHash ^= Zobrist::mix(i + 1);
+            }
 
-                searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft, initDirection, curDirection,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+            searchGoodMove(alienCoordinates, moveDetails, context, energyLeft, i, rootHash, arrowsData, directionDetails, directionArrows);
+            context.dependencies = nullptr;
 
-                // Revert the change
-                zombiesHealth[randomZombieSelected] += 10;
-                moveDetails[3] -= 10;
+            // Only a finished search with all of the alien's energy is the answer for the next hint
+            bool stopped = context.stop != nullptr && *context.stop;
+            if (context.cache != nullptr && energyLeft == this->alien.getEnergy() && !stopped)
+            {
+                context.cache->store(i, directionDetails, directionArrows);
             }
+            goodDirection = this->mergeDirection(i, directionDetails, directionArrows, goodDirection, goodMoveDetails, goodArrowsData);
+        }
+        else
+        {
+            directions.push_back(makeHintTask(context, alienCoordinates, moveDetails, energyLeft, i, context.stateHash, arrowsData));
         }
     }
-    else{
-        // If empty space, just keep moving
-        searchGoodMove({coord.first+rowMove[curDirection], coord.second+colMove[curDirection]}, moveDetails, zombiesHealth, energyLeft, initDirection, curDirection,arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+
+    if (context.pool != nullptr)
+    {
+        this->forkSearch(directions, context.pool);
+        for(int i = 0; i < (int)directions.size(); i++)
+        {
+            context.stats.nodesVisited += directions[i].context.stats.nodesVisited;
+            context.stats.ttHits += directions[i].context.stats.ttHits;
+            context.stats.ttStores += directions[i].context.stats.ttStores;
+            context.stats.cacheHits += directions[i].context.stats.cacheHits;
+            goodDirection = this->mergeDirection(directions[i].direction, directions[i].bestDetails, directions[i].bestArrows, goodDirection, goodMoveDetails, goodArrowsData);
+        }
+    }
+
+    return goodDirection;
+}
+
+// Mark a cell a slide ended on and the zombies that can reach it, for the hint cache
+void Game::recordLeaf(SearchContext& context, pair<int,int>& coord)
+{
+    HintDependencies* dependencies = context.dependencies;
+    if (dependencies == nullptr) return;
+
+    int cell = coord.first * this->cols + coord.second;
+    if (!dependencies->isLeaf[cell])
+    {
+        dependencies->isLeaf[cell] = 1;
+        dependencies->leaves.push_back(cell);
+    }
+
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        if (context.zombiesHealth[i] > 0 && this->zombies[i].isInRange(coord))
+        {
+            dependencies->zombiesUsed[i] = 1;
+        }
+    }
+}
+
+// Let a serial search answer directions from the hint cache
+// Directions whose dependencies changed since the last hint are searched again
+void Game::useHintCache(SearchContext& context)
+{
+    this->hintCache.refresh(this->board, this->alien, this->zombies);
+    for(int i = 0; i < 4; i++)
+    {
+        if (!this->hintCache.valid[i]) this->hintCache.startDirection(i);
+    }
+    context.cache = &this->hintCache;
+}
+
+// Check if the hint cache holds every direction the alien can go
+bool Game::isHintCached()
+{
+    pair<int,int> alienCoordinates = this->alien.getCoordinates();
+    for(int i = 0; i < 4; i++)
+    {
+        if (this->checkCoordinate(alienCoordinates, i) != -1 && !this->hintCache.valid[i]) return false;
+    }
+    return true;
+}
+
+// Keep the direction's best slide if it is at least as good as the best so far
+// Return the direction now in front
+int Game::mergeDirection(int direction, MoveDetails& moveDetails, ArrowStack& arrowsData, int goodDirection, MoveDetails& goodMoveDetails, ArrowStack& goodArrowsData)
+{
+    // A direction cut off by the deadline before its first leaf has nothing to offer
+    if (moveDetails[0] == -INT_MAX) return goodDirection;
+
+    if (moveDetails >= goodMoveDetails)
+    {
+        goodMoveDetails = moveDetails;
+        goodArrowsData = arrowsData;
+        return direction;
+    }
+    return goodDirection;
+}
+
+// Set up context for a search on numOfThreads workers, 1 searches on the calling thread only
+void Game::prepareHintSearch(SearchContext& context, int numOfThreads)
+{
+    if (numOfThreads < 1)
+    {
+        numOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    if (numOfThreads == 1)
+    {
+        this->prepareSearchContext(context, &this->hintTable);
+        return;
+    }
+
+    if (this->hintPool == nullptr || this->hintPool->getNumOfWorkers() != numOfThreads)
+    {
+        this->hintPool = std::make_shared<WorkStealingPool>(numOfThreads);
+    }
+    this->workerTables.resize(numOfThreads);
+    for(int i = 1; i < numOfThreads; i++)
+    {
+        this->workerTables[i].prepare(14);
     }
+
+    this->prepareSearchContext(context, &this->workerTables[0]);
+    context.pool = this->hintPool.get();
+    context.forkDepth = 2;
+    // makeHintTask adds one, so the root tasks start at depth 0
+    context.arrowDepth = -1;
 }
 
 /* 
@@ -905,21 +1759,181 @@ Return :
 */
 pair<int,vector<vector<int>>> Game::getHint()
 {
-    vector<int> moveDetails(6);
-    vector<int> zombiesHealth;
-    for(int i = 0; i < this->numOfZombies; i++)
+    HintResult result;
+    this->getHint(result);
+    return {result.direction, result.arrows.toVectors()};
+}
+
+// Same as getHint, written into result
+// Makes no heap allocation once the search state has been sized by an earlier hint on the same game
+void Game::getHint(HintResult& result)
+{
+    this->prepareHintSearch(this->hintContext, 1);
+    this->useHintCache(this->hintContext);
+
+    MoveDetails goodMoveDetails;
+    goodMoveDetails.fill(-INT_MAX);
+    result.arrows.size = 0;
+    result.direction = this->searchRoots(this->hintContext, this->alien.getEnergy(), goodMoveDetails, result.arrows);
+
+    this->hintStats = this->hintContext.stats;
+}
+
+// Same result as getHint, with the four directions and the arrows near the root spread over numOfThreads workers
+// Each task searches its own copy of the board and zombies health
+pair<int,vector<vector<int>>> Game::getParallelHint(int numOfThreads)
+{
+    SearchContext context;
+    this->prepareHintSearch(context, numOfThreads);
+
+    MoveDetails goodMoveDetails;
+    goodMoveDetails.fill(-INT_MAX);
+    ArrowStack goodArrowsData;
+    int goodDirection = this->searchRoots(context, this->alien.getEnergy(), goodMoveDetails, goodArrowsData);
+
+    this->hintStats = context.stats;
+    return {goodDirection, goodArrowsData.toVectors()};
+}
+
+// Hint that returns within milliseconds
+// Searches with 0 arrow rotations, then 1, and so on up to the alien's energy, keeping the best move found so far
+// Subtrees cached by one pass are reused by the next, the table is keyed by energy left
+TimedHint Game::getHintWithin(int milliseconds, int numOfThreads)
+{
+    SearchContext context;
+    this->prepareHintSearch(context, numOfThreads);
+    if (context.pool == nullptr)
     {
-        zombiesHealth.push_back(this->zombies[i].getHealth());
+        this->useHintCache(context);
+    }
+
+    std::atomic<bool> timedOut(false);
+    context.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    context.stop = &timedOut;
+
+    TimedHint hint;
+    hint.direction = -1;
+    hint.depthReached = -1;
+    hint.complete = false;
+    MoveDetails bestDetails;
+    bestDetails.fill(-INT_MAX);
+
+    // Everything cached already is the full answer, no need to deepen
+    int firstDepth = 0;
+    if (context.cache != nullptr && this->isHintCached())
+    {
+        firstDepth = this->alien.getEnergy();
+    }
+
+    for(int depth = firstDepth; depth <= this->alien.getEnergy(); depth++)
+    {
+        MoveDetails moveDetails;
+        moveDetails.fill(-INT_MAX);
+        ArrowStack arrowsData;
+        int direction = this->searchRoots(context, depth, moveDetails, arrowsData);
+
+        if (timedOut)
+        {
+            // An unfinished pass may still have found something better
+            if (direction != -1 && moveDetails > bestDetails)
+            {
+                hint.direction = direction;
+                hint.arrows = arrowsData;
+            }
+            break;
+        }
+
+        bestDetails = moveDetails;
+        hint.direction = direction;
+        hint.arrows = arrowsData;
+        hint.depthReached = depth;
     }
-    vector<vector<int>> arrowsData;
 
-    vector<int> goodMoveDetails(6, -INT_MAX);
-    vector<vector<int>> goodArrowsData;
+    hint.complete = hint.depthReached == this->alien.getEnergy();
+    this->hintStats = context.stats;
+    return hint;
+}
+
+// Hint that looks rounds rounds ahead, expecting zombies to move like Controller::startGame moves them
+// The moves weighed are, for every direction, the best slide getHint finds and the plain slide without rotations
+// Looks 1 round ahead, then 2, and so on, keeping the deepest pass that fit in nodeBudget nodes
+LookaheadHint Game::getLookaheadHint(int rounds, long long nodeBudget)
+{
+    this->prepareSearchContext(this->hintContext, &this->hintTable);
+
+    MoveDetails moveDetails {};
+    MoveDetails goodMoveDetails;
+    goodMoveDetails.fill(-INT_MAX);
+    ArrowStack goodArrowsData;
     int goodDirection = -1;
+    pair<int,int> alienCoordinates = this->alien.getCoordinates();
+
+    // {direction, arrows to rotate}, the move getHint would pick goes first so it wins ties
+    vector<pair<int,ArrowStack>> plans;
+    for(int i = 0; i < 4; i++)
+    {
+        if (this->checkCoordinate(alienCoordinates, i) == -1) continue;
 
-    searchGoodMove(this->alien.getCoordinates(), moveDetails, zombiesHealth, this->alien.getEnergy(), -1, -1, arrowsData, goodMoveDetails, goodDirection, goodArrowsData);
+        MoveDetails directionDetails;
+        directionDetails.fill(-INT_MAX);
+        ArrowStack directionArrows, arrowsData;
+        this->searchGoodMove(alienCoordinates, moveDetails, this->hintContext, this->alien.getEnergy(), i, this->hintContext.stateHash, arrowsData, directionDetails, directionArrows);
 
-    return {goodDirection, goodArrowsData};
+        int direction = this->mergeDirection(i, directionDetails, directionArrows, goodDirection, goodMoveDetails, goodArrowsData);
+        if (direction != goodDirection)
+        {
+            goodDirection = direction;
+            plans.insert(plans.begin(), {i, directionArrows});
+        }
+        else
+        {
+            plans.push_back({i, directionArrows});
+        }
+        if (directionArrows.size != 0)
+        {
+            plans.push_back({i, ArrowStack()});
+        }
+    }
+
+    LookaheadHint hint;
+    hint.direction = goodDirection;
+    hint.arrows = goodArrowsData;
+    hint.roundsReached = 0;
+    hint.expectedScore = 0;
+
+    this->lookahead.load(this->board, alienCoordinates, this->alien.getHealth(), this->alien.getAttack(), this->zombies);
+    this->lookahead.setNodeBudget(nodeBudget);
+    for(int round = 1; round <= rounds && plans.size() != 0; round++)
+    {
+        int bestPlan = 0;
+        double bestScore = this->lookahead.getLossScore() - 1;
+        for(int i = 0; i < (int)plans.size(); i++)
+        {
+            // Plans that can't beat the best so far are cut off early
+            double score = this->lookahead.searchPlan(plans[i].first, plans[i].second, round, bestScore);
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestPlan = i;
+            }
+        }
+        if (this->lookahead.isBudgetHit()) break;
+
+        hint.direction = plans[bestPlan].first;
+        hint.arrows = plans[bestPlan].second;
+        hint.roundsReached = round;
+        hint.expectedScore = bestScore;
+    }
+
+    this->hintStats = this->hintContext.stats;
+    this->hintStats.nodesVisited += this->lookahead.getNodesVisited();
+    return hint;
+}
+
+// {nodes visited, transposition table hits, transposition table stores, cache hits} of the last hint
+HintStats Game::getHintStats()
+{
+    return this->hintStats;
 }
 
 // Getter
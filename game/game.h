@@ -1,31 +1,179 @@
 #ifndef GAME_H
 #define GAME_H
 #include "game_state.h"
+#include "game_view.h"
+#include "board.h"
+#include "hint_types.h"
+#include "transposition_table.h"
+#include "work_stealing_pool.h"
+#include "hint_cache.h"
+#include "lookahead.h"
+#include "threat_map.h"
+#include "zombie_grid.h"
+#include "turn_order.h"
+#include "journal.h"
+#include "game_event.h"
+#include "random.h"
 #include "characters/zombie.h"
 #include "characters/alien.h"
 #include <vector>
-#include <queue>
 #include <utility>
+#include <cstdint>
+#include <memory>
+#include <chrono>
+#include <atomic>
 
 using std::vector;
 using std::pair;
-using std::queue;
+
+// Counters from the last hint search
+struct HintStats
+{
+    long long nodesVisited, ttHits, ttStores;
+    // First directions answered from the hint cache
+    long long cacheHits;
+};
+
+// Scratch state a hint search works on, so it never touches the live board
+struct SearchContext
+{
+    Board board;
+    vector<int> zombiesHealth;
+    // Zombies don't move during the alien's slide, copied once so the search never scans the board for them
+    vector<pair<int,int>> zombiesCoordinates;
+    // Zombies killed so far along the current slide, 0-indexed
+    vector<int> killedZombies;
+    // Closest zombies of every pod along the current slide, one block per pod
+    vector<int> podTargets;
+    uint64_t stateHash;
+    TranspositionTable* table;
+    HintStats stats;
+    // Parallel hint only: arrows fewer than forkDepth from the root are split into tasks
+    WorkStealingPool* pool;
+    int forkDepth, arrowDepth;
+    // Timed hint only: set stop once the deadline has passed and every search unwinds
+    std::chrono::steady_clock::time_point deadline;
+    std::atomic<bool>* stop;
+    // Serial hint only: the cache answering first directions, and where the current one records what it reads
+    HintCache* cache;
+    HintDependencies* dependencies;
+};
+
+// A branch of the hint search with its own copy of the scratch state
+struct HintTask
+{
+    SearchContext context;
+    pair<int,int> coord;
+    MoveDetails moveDetails;
+    int energyLeft, direction;
+    uint64_t stateHash;
+    ArrowStack arrowsData;
+    MoveDetails bestDetails;
+    ArrowStack bestArrows;
+};
+
+// Hint found within a time budget
+struct TimedHint
+{
+    int direction;
+    ArrowStack arrows;
+    // Most arrow rotations a finished pass allowed, -1 if the first pass did not finish
+    int depthReached;
+    // Every rotation the alien has energy for was searched
+    bool complete;
+};
+
+// Hint that also weighs what the zombies can do in the rounds after the slide
+struct LookaheadHint
+{
+    int direction;
+    ArrowStack arrows;
+    // Rounds a finished pass looked ahead, 0 if not even one round fit in the node budget
+    int roundsReached;
+    // Expected score of the move, see Lookahead::evaluate
+    double expectedScore;
+};
+
+// A move being played out one step at a time, see Game::stepMove
+struct MoveProgress
+{
+    // 0 = Alien, >= 1 = Zombie's ID, -1 = no move in progress
+    int mover;
+    int direction;
+    // See MovePhase in game.cpp
+    int phase;
+    // Cells the alien left, regenerated once the slide is over
+    vector<pair<int,int>> trails;
+    int trailIndex;
+    // One flag per cell (row * cols + col), trails already regenerated
+    vector<char> regenerated;
+};
 
 class Game
 {
     private:
-        vector<vector<char>> board;
-        // ID as an element of queue, 0 = Alien, >= 1 = Zombie's ID
-        queue<int> turnQueue;
+        Board board;
+        // 0 = Alien, >= 1 = Zombie's ID
+        TurnOrder turnOrder;
         int numOfZombies;
         int numOfZombiesAlive, healthLost, attackGained;
+        // Alien moves the player has made, undo takes them back
+        int numberOfPlayerTurns;
+        TranspositionTable hintTable;
+        SearchContext hintContext;
+        HintStats hintStats;
+        HintCache hintCache;
+        std::shared_ptr<WorkStealingPool> hintPool;
+        vector<TranspositionTable> workerTables;
+        Lookahead lookahead;
+        ThreatMap threatMap;
+        ZombieGrid zombieGrid;
+        // Per zombie (by ID - 1), bit d set if it can move in direction d (U, D, L, R)
+        vector<unsigned char> zombieMoves;
+        MoveProgress move;
+        Pcg32 randomEngine;
+        // Every change to the board and the zombies since the oldest checkpoint kept, see checkpoint
+        vector<JournalEntry> journal;
+        vector<JournalCheckpoint> checkpoints;
+        // The checkpoint the game is at, the ones after it can be redone
+        int currentCheckpoint = 0;
+        // How many checkpoints back undo can go, 0 keeps no journal
+        int undoLimit = 0;
 
         void cleanOldData();
-        void generateNewBoard();
+        void generateNewBoard(vector<pair<int,int>>& zombieCoordinates);
+        int randomInt(int n);
         vector<int> getAlienStats();
         vector<vector<int>> getZombieStats();
-        void searchGoodMove(pair<int,int> coord, vector<int>& moveDetails, vector<int>& zombiesHealth, int energyLeft, int initDirection, int curDirection, vector<vector<int>>& arrowsData, vector<int>& goodMoveDetails, int& goodDirection, vector<vector<int>>& goodArrowsData);
-        vector<int> getClosestZombiesFromState(pair<int,int>& coord, vector<int>& zombiesHealth);
+        void buildThreatMap();
+        void buildZombieGrid();
+        void buildZombieMoves();
+        void updateZombieMove(pair<int,int> coordinates);
+        void updateZombieMovesAround(pair<int,int> coordinates);
+        void setCell(int row, int col, char object);
+        void setZombieCell(int row, int col, uint32_t id);
+        void saveZombie(int index);
+        void startJournal();
+        void discardRedo();
+        JournalCheckpoint makeCheckpoint();
+        void restoreCheckpoint(JournalCheckpoint& checkpoint);
+        bool hasChangedSince(JournalCheckpoint& checkpoint);
+        void swapEntry(JournalEntry& entry);
+        void stepAlienMove(vector<GameEvent>& events);
+        void stepZombieMove(vector<GameEvent>& events);
+        void prepareSearchContext(SearchContext& context, TranspositionTable* table);
+        void prepareHintSearch(SearchContext& context, int numOfThreads);
+        void recordLeaf(SearchContext& context, pair<int,int>& coord);
+        void useHintCache(SearchContext& context);
+        bool isHintCached();
+        int mergeDirection(int direction, MoveDetails& moveDetails, ArrowStack& arrowsData, int goodDirection, MoveDetails& goodMoveDetails, ArrowStack& goodArrowsData);
+        int searchRoots(SearchContext& context, int energyLeft, MoveDetails& goodMoveDetails, ArrowStack& goodArrowsData);
+        void searchGoodMove(pair<int,int> coord, MoveDetails& moveDetails, SearchContext& context, int energyLeft, int curDirection, uint64_t stateHash, ArrowStack& arrowsData, MoveDetails& goodMoveDetails, ArrowStack& goodArrowsData);
+        HintTask makeHintTask(SearchContext& context, pair<int,int> coord, MoveDetails& moveDetails, int energyLeft, int direction, uint64_t stateHash, ArrowStack& arrowsData);
+        void forkSearch(vector<HintTask>& tasks, WorkStealingPool* pool);
+        void searchPodTarget(int target, pair<int,int> coord, MoveDetails& moveDetails, SearchContext& context, int energyLeft, int curDirection, uint64_t stateHash, ArrowStack& arrowsData, MoveDetails& goodMoveDetails, ArrowStack& goodArrowsData);
+        int getDamageAt(pair<int,int>& coord, SearchContext& context);
+        int getClosestDistanceFromState(pair<int,int>& coord, SearchContext& context);
         vector<int> getClosestZombies();
 
     public:
@@ -38,9 +186,12 @@ class Game
         pair<int, int> getZombieCoordinatesFromBoard(int zombieID);
         int getCurrentTurn() ;
         void newGame(int rows, int cols, int numofZombies, int difficulty);
+        void newGame(int rows, int cols, int numofZombies, int difficulty, uint64_t seed);
         void loadGame(GameState& save);
         void nextTurn();
+        void getNextTurns(int count, vector<int>& actors);
         GameState getGameState();
+        GameView getView();
         int checkCoordinate(pair<int,int>& coord, int direction);
         void changeArrowDirection(pair<int,int> arrowCoordinates, int newDirection);
         void moveZombie(int id, int direction);
@@ -52,8 +203,24 @@ class Game
         void encounterRock(pair<int,int> rockCoordinates);
         void encounterHealth();
         void encounterArrow();
+        void beginAlienMove(int direction);
+        void beginZombieMove(int id, int direction);
+        bool stepMove(vector<GameEvent>& events);
+        void applyAlienMove(int direction, vector<GameEvent>& events);
+        void applyZombieMove(int id, int direction, vector<GameEvent>& events);
+        int getRandomZombieDirection(int id);
+        int getZombieMoves(int id);
         int getNumOfZombiesAlive();
+        void setUndoLimit(int limit);
+        void checkpoint();
+        bool undo();
+        bool redo();
         pair<int,vector<vector<int>>> getHint();
+        void getHint(HintResult& result);
+        pair<int,vector<vector<int>>> getParallelHint(int numOfThreads = 0);
+        TimedHint getHintWithin(int milliseconds, int numOfThreads = 1);
+        LookaheadHint getLookaheadHint(int rounds, long long nodeBudget = 1000000);
+        HintStats getHintStats();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef GAME_EVENT_H
+#define GAME_EVENT_H
+
+#include <utility>
+using std::pair;
+
+// What a step of a move did, in the order it happened
+enum GameEventType
+{
+    // Alien moved onto an empty cell or a trail
+    ALIEN_MOVED,
+    // Alien moved onto an arrow, gained 20 attack and turned
+    ALIEN_ARROW,
+    // Alien moved onto a health pack, amount is the health gained
+    ALIEN_HEALTH,
+    // Alien moved onto a pod that hit zombieID for amount damage
+    ALIEN_POD,
+    // Alien broke the rock at coordinates and stopped
+    ALIEN_ROCK,
+    // Alien is about to attack zombieID, nothing has changed yet
+    ALIEN_ZOMBIE_AHEAD,
+    // Alien killed zombieID and moved onto its cell
+    ALIEN_ZOMBIE_KILLED,
+    // Alien hit zombieID for amount damage, it survived and the alien stopped
+    ALIEN_ZOMBIE_SURVIVED,
+    // Alien hit the edge of the board and stopped
+    ALIEN_WALL,
+    // Trail at coordinates turned into a random object
+    TRAIL_REGENERATED,
+    // Zombie zombieID moved onto coordinates
+    ZOMBIE_MOVED,
+    // Zombie zombieID is boxed in at coordinates and stays there
+    ZOMBIE_PASSED,
+    // Zombie zombieID is about to break the rock at coordinates, nothing has changed yet
+    ZOMBIE_ROCK,
+    // Zombie zombieID attacked the alien for amount damage, 0 if the alien was out of range
+    ZOMBIE_ATTACK
+};
+
+struct GameEvent
+{
+    GameEventType type;
+    // 1-indexed, 0 if no zombie is involved
+    int zombieID;
+    int amount;
+    // Cell the event happened on
+    pair<int,int> coordinates;
+};
+
+#endif
@@ -2,16 +2,20 @@
 #define GAME_STATE_H
 
 #include <vector>
+#include <cstdint>
+#include "board.h"
 using std::vector;
 
 struct GameState
 {
 	int rows, cols;
-    vector<vector<char>> board;
+    Board board;
 	vector<int> alienAttributes;
 	int numberOfZombies;
 	vector<vector<int>> zombieAttributes;
 	int numberOfPlayerTurns, healthLost, attackGained;
+	// Where the game's random engine is, see Pcg32
+	uint64_t randomSeed, randomPosition;
 };
 
 #endif
\ No newline at end of file
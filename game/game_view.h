@@ -0,0 +1,20 @@
+#ifndef GAME_VIEW_H
+#define GAME_VIEW_H
+
+#include "board.h"
+#include "characters/zombie.h"
+
+// Read-only look at a live Game for drawing it, unlike GameState nothing is copied
+// It points into the game, get a new one after the game changes
+struct GameView
+{
+    const Board& board;
+    int alienHealth, alienAttack, alienEnergy;
+    int numberOfZombies;
+    // By ID - 1, dead ones included
+    const Zombie* zombies;
+    // 0 = Alien, >= 1 = Zombie's ID
+    int currentTurn;
+};
+
+#endif
\ No newline at end of file
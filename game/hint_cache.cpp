@@ -0,0 +1,119 @@
+#include "hint_cache.h"
+
+HintCache::HintCache()
+{
+    this->invalidateAll();
+}
+
+void HintCache::invalidateAll()
+{
+    for(int i = 0; i < 4; i++)
+    {
+        this->valid[i] = false;
+    }
+}
+
+// {ID, row, col, health, attack, range} of a zombie
+static std::array<int, 6> getZombieRow(Zombie& zombie)
+{
+    return {zombie.getID(), zombie.getCoordinates().first, zombie.getCoordinates().second, zombie.getHealth(), zombie.getAttack(), zombie.getRange()};
+}
+
+// Check if the zombie {ID, row, col, health, attack, range} can reach any leaf of a direction
+bool HintCache::zombieReachesLeaf(std::array<int, 6>& zombie, HintDependencies& dependencies)
+{
+    int cols = this->board.getCols();
+    for(int i = 0; i < (int)dependencies.leaves.size(); i++)
+    {
+        int diffRow = dependencies.leaves[i] / cols - zombie[1];
+        int diffCol = dependencies.leaves[i] % cols - zombie[2];
+        if (diffRow * diffRow + diffCol * diffCol <= zombie[5] * zombie[5]) return true;
+    }
+    return false;
+}
+
+// Compare the game with what the cache was searched against and drop the directions it affects
+void HintCache::refresh(Board& board, Alien& alien, vector<Zombie>& zombies)
+{
+    std::array<int, 5> alienStats = {alien.getCoordinates().first, alien.getCoordinates().second, alien.getHealth(), alien.getAttack(), alien.getEnergy()};
+
+    // The alien is where every direction starts, its health, attack and energy are used all over the search
+    bool sameShape = 
+        board.getRows() == this->board.getRows() && 
+        board.getCols() == this->board.getCols() && 
+        zombies.size() == this->zombieStats.size();
+
+    if (!sameShape || alienStats != this->alienStats)
+    {
+        this->invalidateAll();
+    }
+    else
+    {
+        // Cells that changed, a direction that read one of them is stale
+        for(int row = 0; row < board.getRows(); row++)
+        {
+            for(int col = 0; col < board.getCols(); col++)
+            {
+                if (board.get(row, col) == this->board.get(row, col)) continue;
+
+                int cell = row * board.getCols() + col;
+                for(int i = 0; i < 4; i++)
+                {
+                    if (this->valid[i] && this->dependencies[i].cellsRead[cell]) this->valid[i] = false;
+                }
+            }
+        }
+
+        // Zombies that moved, got hurt or died
+        for(int z = 0; z < (int)zombies.size(); z++)
+        {
+            std::array<int, 6> zombie = getZombieRow(zombies[z]);
+            if (zombie == this->zombieStats[z]) continue;
+
+            // Whether any zombie is alive decides the win, so a death or revival affects every direction
+            bool aliveChanged = (zombie[3] > 0) != (this->zombieStats[z][3] > 0);
+            for(int i = 0; i < 4; i++)
+            {
+                if (!this->valid[i]) continue;
+
+                HintDependencies& dependencies = this->dependencies[i];
+                if (aliveChanged || dependencies.usedPod || dependencies.zombiesUsed[z] || this->zombieReachesLeaf(zombie, dependencies))
+                {
+                    this->valid[i] = false;
+                }
+            }
+        }
+    }
+
+    this->board = board;
+    this->alienStats = alienStats;
+    this->zombieStats.resize(zombies.size());
+    for(int z = 0; z < (int)zombies.size(); z++)
+    {
+        this->zombieStats[z] = getZombieRow(zombies[z]);
+    }
+}
+
+// Forget what a direction depended on before it is searched again
+void HintCache::startDirection(int direction)
+{
+    HintDependencies& dependencies = this->dependencies[direction];
+    int numOfCells = this->board.getRows() * this->board.getCols();
+
+    dependencies.cellsRead.assign(numOfCells, 0);
+    dependencies.isLeaf.assign(numOfCells, 0);
+    dependencies.leaves.clear();
+    // Every cell can be a leaf at most once, so pushing leaves never has to grow it
+    dependencies.leaves.reserve(numOfCells);
+    dependencies.zombiesUsed.assign(this->zombieStats.size(), 0);
+    dependencies.usedPod = false;
+    this->valid[direction] = false;
+}
+
+// Keep the finished search of a direction
+void HintCache::store(int direction, MoveDetails& moveDetails, ArrowStack& arrowsData)
+{
+    this->bestDetails[direction] = moveDetails;
+    this->bestArrows[direction] = arrowsData;
+    this->valid[direction] = true;
+}
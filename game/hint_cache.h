@@ -0,0 +1,54 @@
+#ifndef HINT_CACHE_H
+#define HINT_CACHE_H
+
+#include <vector>
+#include <array>
+#include "board.h"
+#include "hint_types.h"
+#include "characters/alien.h"
+#include "characters/zombie.h"
+
+using std::vector;
+
+// What the search of one first direction looked at
+struct HintDependencies
+{
+    // One flag per board cell (row * cols + col)
+    vector<char> cellsRead;
+    // Cells a slide ended on, a zombie in range of one of them changes the damage taken
+    vector<char> isLeaf;
+    vector<int> leaves;
+    // Zombies in range of a leaf or hit by the alien, 0-indexed
+    vector<char> zombiesUsed;
+    // Pods hit the closest zombie, so every zombie matters
+    bool usedPod;
+};
+
+// Hint results kept between hints, one per first direction (U, D, L, R)
+// A direction is searched again only when something its search depended on has changed
+class HintCache
+{
+    private:
+        // What the cached results were searched against
+        // {row, column, health, attack, energy} and {{ID, row, col, health, attack, range}}
+        Board board;
+        // Kept in fixed-size rows so a refresh never allocates
+        std::array<int, 5> alienStats;
+        vector<std::array<int, 6>> zombieStats;
+
+        bool zombieReachesLeaf(std::array<int, 6>& zombie, HintDependencies& dependencies);
+
+    public:
+        bool valid[4];
+        MoveDetails bestDetails[4];
+        ArrowStack bestArrows[4];
+        HintDependencies dependencies[4];
+
+        HintCache();
+        void invalidateAll();
+        void refresh(Board& board, Alien& alien, vector<Zombie>& zombies);
+        void startDirection(int direction);
+        void store(int direction, MoveDetails& moveDetails, ArrowStack& arrowsData);
+};
+
+#endif
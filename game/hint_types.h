@@ -0,0 +1,67 @@
+#ifndef HINT_TYPES_H
+#define HINT_TYPES_H
+
+#include <array>
+#include <vector>
+#include <cassert>
+#include "characters/alien.h"
+
+using std::vector;
+
+// Most arrows the alien can rotate in a single hint, one per energy
+const int maxArrowChanges = Alien::maxEnergy;
+
+// {win/lose, netHealth, zombieSlained, attackDealt, attackGain, isARock}
+// Compared lexicographically, a bigger one is a better move
+typedef std::array<int, 6> MoveDetails;
+
+// An arrow to rotate before moving
+struct ArrowChange
+{
+    int row, col, direction;
+};
+
+// Arrows rotated along a slide, in order
+// Fixed capacity so the hint search can push, pop and copy them without touching the heap
+struct ArrowStack
+{
+    ArrowChange changes[maxArrowChanges];
+    int size;
+
+    ArrowStack()
+    {
+        this->size = 0;
+    }
+
+    void push(int row, int col, int direction)
+    {
+        assert(this->size < maxArrowChanges);
+        this->changes[this->size++] = {row, col, direction};
+    }
+
+    void pop()
+    {
+        this->size--;
+    }
+
+    // {{arrowRow, arrowCol, direction}}, the layout Display::displayHint takes
+    vector<vector<int>> toVectors() const
+    {
+        vector<vector<int>> arrows(this->size);
+        for(int i = 0; i < this->size; i++)
+        {
+            arrows[i] = {this->changes[i].row, this->changes[i].col, this->changes[i].direction};
+        }
+        return arrows;
+    }
+};
+
+// Where a hint is written, so asking for one doesn't allocate
+struct HintResult
+{
+    // 0, 1, 2, 3 (U, D, L, R), -1 if there is nowhere to go
+    int direction;
+    ArrowStack arrows;
+};
+
+#endif
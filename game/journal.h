@@ -0,0 +1,37 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <cstdint>
+#include "turn_order.h"
+#include "random.h"
+#include "characters/alien.h"
+#include "characters/zombie.h"
+
+// One change to the board or to a zombie, written by the Game mutator that made it
+// Undoing swaps the saved value with the live one, so the same entry redoes the change later
+struct JournalEntry
+{
+    // 0 = board cell, 1 = zombie
+    int kind;
+    // Cell (row * cols + col) or zombie index
+    int index;
+    char cell;
+    // Zombie ID on the cell, see Board::getZombieID
+    uint32_t occupant;
+    Zombie zombie;
+};
+
+// State the game can be rolled back to with Game::undo
+// The board and the zombies are rebuilt from the journal, everything else is small enough to copy whole
+struct JournalCheckpoint
+{
+    // Journal entries from here on were made after the checkpoint
+    int start;
+    Alien alien;
+    int numOfZombiesAlive, healthLost, attackGained, numberOfPlayerTurns;
+    bool gameOver;
+    TurnPosition turn;
+    Pcg32 randomEngine;
+};
+
+#endif
@@ -0,0 +1,446 @@
+#include "lookahead.h"
+#include <algorithm>
+#include <climits>
+
+// U, D, L, R
+static const int rowMove[4] = {-1, 1, 0, 0};
+static const int colMove[4] = {0, 0, -1, 1};
+
+Lookahead::Lookahead()
+{
+    this->nodesVisited = 0;
+    this->nodeBudget = 0;
+    this->budgetHit = false;
+}
+
+// Copy the game the lookahead starts from
+void Lookahead::load(Board& board, pair<int,int> alienCoordinates, int alienHealth, int alienAttack, vector<Zombie>& zombies)
+{
+    this->board = board;
+    this->alienCoordinates = alienCoordinates;
+    this->alienHealth = alienHealth;
+    this->alienAttack = alienAttack;
+    this->zombies = zombies;
+    this->numOfZombies = zombies.size();
+    this->numOfZombiesAlive = 0;
+    this->startZombiesHealth = 0;
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        this->numOfZombiesAlive += this->zombies[i].isAlive();
+        this->startZombiesHealth += this->zombies[i].getHealth();
+    }
+    this->startHealth = alienHealth;
+    // Losing is worse than keeping 1 health, winning is better than leaving one zombie with 1 health
+    this->lossScore = -4.0 * this->startHealth - 1;
+    this->winScore = 4.0 * (200 - this->startHealth) + this->startZombiesHealth + 1;
+    this->undoLog.clear();
+    this->nodesVisited = 0;
+    this->budgetHit = false;
+}
+
+// Most nodes a search may visit before it gives up
+void Lookahead::setNodeBudget(long long nodeBudget)
+{
+    this->nodeBudget = nodeBudget;
+}
+
+double Lookahead::getLossScore()
+{
+    return this->lossScore;
+}
+
+long long Lookahead::getNodesVisited()
+{
+    return this->nodesVisited;
+}
+
+// Check if a search ran out of nodes, its result is then only a guess
+bool Lookahead::isBudgetHit()
+{
+    return this->budgetHit;
+}
+
+int Lookahead::mark()
+{
+    return this->undoLog.size();
+}
+
+// Put back every change made since mark
+void Lookahead::undoTo(int mark)
+{
+    while ((int)this->undoLog.size() > mark)
+    {
+        LookaheadUndo& undo = this->undoLog.back();
+        if (undo.kind == 0)
+        {
+            int row = undo.index / this->board.getCols(), col = undo.index % this->board.getCols();
+            if (cellTable[(unsigned char)undo.cell] == ZOMBIE) this->board.setZombie(row, col, undo.occupant);
+            else this->board.set(row, col, undo.cell);
+        }
+        else if (undo.kind == 1)
+        {
+            this->zombies[undo.index] = undo.zombie;
+            this->numOfZombiesAlive = undo.numOfZombiesAlive;
+        }
+        else
+        {
+            this->alienCoordinates = undo.alienCoordinates;
+            this->alienHealth = undo.alienHealth;
+        }
+        this->undoLog.pop_back();
+    }
+}
+
+void Lookahead::setCell(int row, int col, char object)
+{
+    LookaheadUndo undo;
+    undo.kind = 0;
+    undo.index = row * this->board.getCols() + col;
+    undo.cell = this->board.get(row, col);
+    undo.occupant = this->board.getZombieID(row, col);
+    this->undoLog.push_back(undo);
+    this->board.set(row, col, object);
+}
+
+// Same as setCell, for putting zombie id on the cell
+void Lookahead::setZombieCell(int row, int col, uint32_t id)
+{
+    this->setCell(row, col, Board::zombieSymbol(id));
+    this->board.setZombie(row, col, id);
+}
+
+// Call before changing zombie index or the number of zombies alive
+void Lookahead::saveZombie(int index)
+{
+    LookaheadUndo undo;
+    undo.kind = 1;
+    undo.index = index;
+    undo.zombie = this->zombies[index];
+    undo.numOfZombiesAlive = this->numOfZombiesAlive;
+    this->undoLog.push_back(undo);
+}
+
+// Call before moving or hurting the alien
+void Lookahead::saveAlien()
+{
+    LookaheadUndo undo;
+    undo.kind = 2;
+    undo.alienCoordinates = this->alienCoordinates;
+    undo.alienHealth = this->alienHealth;
+    this->undoLog.push_back(undo);
+}
+
+bool Lookahead::isOver()
+{
+    return this->alienHealth <= 0 || this->numOfZombiesAlive == 0;
+}
+
+// The closest zombies alive to {row, col} are pushed onto podTargets, in index order, same as Game::getClosestZombies
+void Lookahead::findPodTargets(int row, int col)
+{
+    int minimalDistance = INT_MAX;
+    int firstTarget = this->podTargets.size();
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        if (!this->zombies[i].isAlive()) continue;
+        pair<int,int> zombieCoordinates = this->zombies[i].getCoordinates();
+        int distance =
+            (row - zombieCoordinates.first) * (row - zombieCoordinates.first)
+            +
+            (col - zombieCoordinates.second) * (col - zombieCoordinates.second)
+        ;
+        if (distance > minimalDistance) continue;
+        if (distance < minimalDistance) this->podTargets.resize(firstTarget);
+        minimalDistance = distance;
+        this->podTargets.push_back(i);
+    }
+}
+
+// Slide the alien like Game::stepMove, starting with attack, then score the rest of round
+double Lookahead::slideAlien(int direction, int attack, int round, int rounds, double alpha, double beta)
+{
+    this->saveAlien();
+    // Slides further down push their trails after this one's and take them off again before returning
+    int firstTrail = this->trails.size();
+    double value = this->carryOnSlide(direction, attack, firstTrail, round, rounds, alpha, beta);
+    this->trails.resize(firstTrail);
+    return value;
+}
+
+// Rest of slideAlien from where the alien is now, firstTrail is where the slide's trails start
+// The pod hits one of the closest zombies at random, so the slide carries on after each of them and the worst counts,
+// the same as the hint in Game::searchGoodMove
+double Lookahead::carryOnSlide(int direction, int attack, int firstTrail, int round, int rounds, double alpha, double beta)
+{
+    while (true)
+    {
+        int row = this->alienCoordinates.first;
+        int col = this->alienCoordinates.second;
+        int nextRow = row + rowMove[direction];
+        int nextCol = col + colMove[direction];
+        int result = this->board.checkCell(nextRow, nextCol);
+
+        if (result == 6)
+        {
+            // The rock breaks and the alien stops
+            this->setCell(nextRow, nextCol, ' ');
+            break;
+        }
+        if (result == 9)
+        {
+            int index = this->board.getZombieID(nextRow, nextCol) - 1;
+            this->saveZombie(index);
+            this->zombies[index].receiveAttack(attack);
+            if (this->zombies[index].isAlive()) break;
+            this->numOfZombiesAlive--;
+        }
+        else if (result == 5)
+        {
+            int firstTarget = this->podTargets.size();
+            this->findPodTargets(row, col);
+            int lastTarget = this->podTargets.size();
+            if (firstTarget != lastTarget)
+            {
+                this->trails.push_back({row, col});
+                this->setCell(row, col, '.');
+                this->setCell(nextRow, nextCol, 'A');
+                this->alienCoordinates = {nextRow, nextCol};
+                int lastTrail = this->trails.size();
+
+                // Closest zombie to the alien takes 10 damage
+                double worst = this->winScore;
+                for(int t = firstTarget; t < lastTarget; t++)
+                {
+                    int target = this->podTargets[t];
+                    int start = this->mark();
+                    this->saveZombie(target);
+                    this->zombies[target].receiveAttack(10);
+                    if (!this->zombies[target].isAlive())
+                    {
+                        pair<int,int> zombieCoordinates = this->zombies[target].getCoordinates();
+                        this->setCell(zombieCoordinates.first, zombieCoordinates.second, ' ');
+                        this->numOfZombiesAlive--;
+                    }
+
+                    double value = this->numOfZombiesAlive == 0
+                        ? this->endSlide(firstTrail, round, rounds, alpha, std::min(beta, worst))
+                        : this->carryOnSlide(direction, attack, firstTrail, round, rounds, alpha, std::min(beta, worst));
+                    this->undoTo(start);
+                    this->trails.resize(lastTrail);
+
+                    worst = std::min(worst, value);
+                    if (worst <= alpha) break;
+                }
+                this->podTargets.resize(firstTarget);
+                return worst;
+            }
+        }
+        else if (result == 4)
+        {
+            this->alienHealth = std::min(200, this->alienHealth + 20);
+        }
+        else if (result >= 0 && result <= 3)
+        {
+            attack += 20;
+        }
+        else if (result == 7 || result == 10)
+        {
+            // Nothing happens on empty space, go straight to the end of the run
+            int run = this->board.openRun(row, col, direction);
+            nextRow = row + run * rowMove[direction];
+            nextCol = col + run * colMove[direction];
+        }
+        else
+        {
+            break;
+        }
+
+        this->trails.push_back({row, col});
+        this->setCell(row, col, '.');
+        this->setCell(nextRow, nextCol, 'A');
+        this->alienCoordinates = {nextRow, nextCol};
+        if (result >= 0 && result <= 3) direction = result;
+        if (this->numOfZombiesAlive == 0) break;
+    }
+
+    return this->endSlide(firstTrail, round, rounds, alpha, beta);
+}
+
+// The slide is over, score it and the zombie turns after it
+double Lookahead::endSlide(int firstTrail, int round, int rounds, double alpha, double beta)
+{
+    // Trails spawn random objects, taken as empty space
+    for(int i = firstTrail; i < (int)this->trails.size(); i++)
+    {
+        if (this->trails[i] == this->alienCoordinates) continue;
+        if (this->board.get(this->trails[i].first, this->trails[i].second) != '.') continue;
+        this->setCell(this->trails[i].first, this->trails[i].second, ' ');
+    }
+    return this->isOver() ? this->evaluate() : this->zombieNode(round, rounds, 0, alpha, beta);
+}
+
+// Score of the state, higher is better for the alien
+// Health kept counts 4 times as much as damage dealt to zombies
+double Lookahead::evaluate()
+{
+    if (this->alienHealth <= 0) return this->lossScore;
+    if (this->numOfZombiesAlive == 0) return this->winScore;
+
+    int zombiesHealth = 0;
+    for(int i = 0; i < this->numOfZombies; i++)
+    {
+        zombiesHealth += this->zombies[i].getHealth();
+    }
+    return 4.0 * (this->alienHealth - this->startHealth) + (this->startZombiesHealth - zombiesHealth);
+}
+
+bool Lookahead::isNodeLimit()
+{
+    if (this->nodesVisited >= this->nodeBudget) this->budgetHit = true;
+    return this->budgetHit;
+}
+
+// Alien's turn in round: best of the slides in every direction, without rotating arrows
+double Lookahead::alienNode(int round, int rounds, double alpha, double beta)
+{
+    this->nodesVisited++;
+    if (this->isNodeLimit()) return this->evaluate();
+
+    bool moved = false;
+    double best = this->lossScore;
+    for(int i = 0; i < 4; i++)
+    {
+        if (this->board.checkCell(this->alienCoordinates.first + rowMove[i], this->alienCoordinates.second + colMove[i]) == -1) continue;
+
+        int start = this->mark();
+        double value = this->slideAlien(i, this->alienAttack, round, rounds, std::max(alpha, best), beta);
+        this->undoTo(start);
+
+        if (!moved || value > best) best = value;
+        moved = true;
+        if (best >= beta) break;
+    }
+
+    // Nowhere to go, the zombies carry on
+    if (!moved) return this->zombieNode(round, rounds, 0, alpha, beta);
+    return best;
+}
+
+// Zombie index's turn in round, a chance node over its valid directions
+// Pruned with Star1: once the directions left can't move the average back inside (alpha, beta), stop
+double Lookahead::zombieNode(int round, int rounds, int index, double alpha, double beta)
+{
+    while (index < this->numOfZombies && !this->zombies[index].isAlive()) index++;
+    if (index == this->numOfZombies)
+    {
+        if (round == rounds) return this->evaluate();
+        return this->alienNode(round + 1, rounds, alpha, beta);
+    }
+
+    this->nodesVisited++;
+    if (this->isNodeLimit()) return this->evaluate();
+
+    // Same choice as Game::getRandomZombieDirection, anything but off the board, the alien or another zombie
+    pair<int,int> coord = this->zombies[index].getCoordinates();
+    int directions[4];
+    int numOfDirections = 0;
+    bool reachesAlien = this->zombies[index].isInRange(this->alienCoordinates);
+    for(int i = 0; i < 4; i++)
+    {
+        int result = this->board.checkCell(coord.first + rowMove[i], coord.second + colMove[i]);
+        if (result == -1 || result == 8 || result == 9) continue;
+        directions[numOfDirections++] = i;
+
+        Zombie moved = this->zombies[index];
+        moved.move(rowMove[i], colMove[i]);
+        reachesAlien = reachesAlien || moved.isInRange(this->alienCoordinates);
+    }
+
+    // A boxed-in zombie passes, same as Game::getRandomZombieDirection, but still attacks from where it is
+    if (numOfDirections == 0 && this->zombies[index].isInRange(this->alienCoordinates))
+    {
+        int start = this->mark();
+        this->saveAlien();
+        this->alienHealth = std::max(this->alienHealth - this->zombies[index].getAttack(), 0);
+        double value = this->isOver() ? this->evaluate() : this->zombieNode(round, rounds, index + 1, alpha, beta);
+        this->undoTo(start);
+        return value;
+    }
+
+    // In the last round only attacks are left to score, a zombie that can't get in range changes nothing
+    // (it could still block a later zombie, which is ignored)
+    if (round == rounds && !reachesAlien) numOfDirections = 0;
+
+    if (numOfDirections == 0)
+    {
+        return this->zombieNode(round, rounds, index + 1, alpha, beta);
+    }
+
+    int zombieID = this->zombies[index].getID();
+    double sum = 0;
+    for(int k = 0; k < numOfDirections; k++)
+    {
+        int direction = directions[k];
+        int left = numOfDirections - k - 1;
+        // Window this child must land in for the average to stay inside (alpha, beta)
+        double childAlpha = numOfDirections * alpha - sum - left * this->winScore;
+        double childBeta = numOfDirections * beta - sum - left * this->lossScore;
+
+        int start = this->mark();
+        int nextRow = coord.first + rowMove[direction];
+        int nextCol = coord.second + colMove[direction];
+        if (this->board.checkCell(nextRow, nextCol) == 6)
+        {
+            // The rock breaks and the zombie stays
+            this->setCell(nextRow, nextCol, ' ');
+        }
+        else
+        {
+            this->setCell(coord.first, coord.second, ' ');
+            this->saveZombie(index);
+            this->zombies[index].move(rowMove[direction], colMove[direction]);
+            this->setZombieCell(nextRow, nextCol, zombieID);
+        }
+
+        // Same as Game::attackAlien
+        if (this->zombies[index].isInRange(this->alienCoordinates))
+        {
+            this->saveAlien();
+            this->alienHealth = std::max(this->alienHealth - this->zombies[index].getAttack(), 0);
+        }
+
+        double value = this->isOver()
+            ? this->evaluate()
+            : this->zombieNode(round, rounds, index + 1, std::max(childAlpha, this->lossScore), std::min(childBeta, this->winScore));
+        this->undoTo(start);
+        sum += value;
+
+        // The directions left can't lift the average above alpha, or drop it below beta
+        if (value <= childAlpha) return (sum + left * this->winScore) / numOfDirections;
+        if (value >= childBeta) return (sum + left * this->lossScore) / numOfDirections;
+    }
+    return sum / numOfDirections;
+}
+
+// Expected score of rotating arrows and sliding in direction, looking rounds rounds ahead
+// A plan that can't beat alpha returns alpha or less
+double Lookahead::searchPlan(int direction, ArrowStack& arrows, int rounds, double alpha)
+{
+    static const char arrowChars[4] = {'^', 'v', '<', '>'};
+    this->nodesVisited++;
+
+    int start = this->mark();
+    for(int i = 0; i < arrows.size; i++)
+    {
+        this->setCell(arrows.changes[i].row, arrows.changes[i].col, arrowChars[arrows.changes[i].direction]);
+    }
+
+    // The alien's attack is back to 0 after its first slide
+    int firstAttack = this->alienAttack;
+    this->alienAttack = 0;
+    double value = this->slideAlien(direction, firstAttack, 1, rounds, alpha, this->winScore);
+    this->alienAttack = firstAttack;
+
+    this->undoTo(start);
+    return value;
+}
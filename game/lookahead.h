@@ -0,0 +1,84 @@
+#ifndef LOOKAHEAD_H
+#define LOOKAHEAD_H
+
+#include <vector>
+#include <utility>
+#include "board.h"
+#include "hint_types.h"
+#include "characters/zombie.h"
+
+using std::vector;
+using std::pair;
+
+// One change to the lookahead state, undone in reverse order
+struct LookaheadUndo
+{
+    // 0 = board cell, 1 = zombie, 2 = alien
+    int kind;
+    // Cell (row * cols + col) or zombie index
+    int index;
+    char cell;
+    // Zombie ID on the cell, see Board::getZombieID
+    uint32_t occupant;
+    Zombie zombie;
+    pair<int,int> alienCoordinates;
+    int alienHealth, numOfZombiesAlive;
+};
+
+/*
+    Expectimax over the next rounds of the game, used by the lookahead hint
+
+    A round is the alien's slide (max node) followed by every zombie's turn in ID order (one chance node per zombie,
+    each valid direction equally likely, the same way Game::getRandomZombieDirection picks them)
+    Slides and zombie turns follow Game::stepMove, except that
+    whatever spawns randomly (trails, broken rocks) is taken to be empty space, and a pod hits the worst of the closest zombies
+*/
+class Lookahead
+{
+    private:
+        Board board;
+        pair<int,int> alienCoordinates;
+        int alienHealth, alienAttack;
+        vector<Zombie> zombies;
+        int numOfZombies, numOfZombiesAlive;
+        int startHealth, startZombiesHealth;
+        vector<LookaheadUndo> undoLog;
+        // Cells the slides in progress left, each slide's after the one it is nested in
+        vector<pair<int,int>> trails;
+        // Closest zombies of the pods in progress, each pod's after the one before it
+        vector<int> podTargets;
+
+        // Scores of a lost and a won game, every other score lies strictly between them
+        // The closer together they are the more Star1 prunes
+        double lossScore, winScore;
+
+        long long nodesVisited, nodeBudget;
+        bool budgetHit;
+
+        int mark();
+        void undoTo(int mark);
+        void setCell(int row, int col, char object);
+        void setZombieCell(int row, int col, uint32_t id);
+        void saveZombie(int index);
+        void saveAlien();
+        bool isOver();
+        void findPodTargets(int row, int col);
+        double slideAlien(int direction, int attack, int round, int rounds, double alpha, double beta);
+        double carryOnSlide(int direction, int attack, int firstTrail, int round, int rounds, double alpha, double beta);
+        double endSlide(int firstTrail, int round, int rounds, double alpha, double beta);
+        double evaluate();
+        bool isNodeLimit();
+        double alienNode(int round, int rounds, double alpha, double beta);
+        double zombieNode(int round, int rounds, int index, double alpha, double beta);
+
+    public:
+        Lookahead();
+        void load(Board& board, pair<int,int> alienCoordinates, int alienHealth, int alienAttack, vector<Zombie>& zombies);
+        void setNodeBudget(long long nodeBudget);
+        double searchPlan(int direction, ArrowStack& arrows, int rounds, double alpha);
+        double getLossScore();
+        long long getNodesVisited();
+        bool isBudgetHit();
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "random.h"
+
+// PCG's default multiplier and stream
+static const uint64_t multiplier = 6364136223846793005ULL;
+static const uint64_t defaultIncrement = 1442695040888963407ULL;
+
+Pcg32::Pcg32()
+{
+    this->seed(0);
+}
+
+// Start over from seed, the same seed always gives the same numbers
+void Pcg32::seed(uint64_t seed)
+{
+    this->increment = defaultIncrement;
+    this->state = seed + this->increment;
+    this->state = this->state * multiplier + this->increment;
+    this->initialSeed = seed;
+    this->position = 0;
+}
+
+// Skip the next delta numbers without drawing them, O(log delta)
+void Pcg32::advance(uint64_t delta)
+{
+    uint64_t currentMultiplier = multiplier, currentIncrement = this->increment;
+    uint64_t totalMultiplier = 1, totalIncrement = 0;
+    this->position += delta;
+    while (delta > 0)
+    {
+        if (delta & 1)
+        {
+            totalMultiplier *= currentMultiplier;
+            totalIncrement = totalIncrement * currentMultiplier + currentIncrement;
+        }
+        currentIncrement *= currentMultiplier + 1;
+        currentMultiplier *= currentMultiplier;
+        delta >>= 1;
+    }
+    this->state = totalMultiplier * this->state + totalIncrement;
+}
+
+// Put the engine back where getSeed and getPosition said it was
+void Pcg32::restore(uint64_t seed, uint64_t position)
+{
+    this->seed(seed);
+    this->advance(position);
+}
+
+uint64_t Pcg32::getSeed()
+{
+    return this->initialSeed;
+}
+
+// How many numbers have been drawn since seeding
+uint64_t Pcg32::getPosition()
+{
+    return this->position;
+}
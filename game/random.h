@@ -0,0 +1,43 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/*
+    PCG32 (XSH RR) random engine, see pcg-random.org
+
+    Small and fast, and it can jump ahead any number of draws in O(log n), so a game is restored exactly
+    from its seed and how many numbers it has drawn (its position) instead of the whole engine state
+    Satisfies UniformRandomBitGenerator, so it works with std::shuffle and the std distributions
+*/
+class Pcg32
+{
+    private:
+        uint64_t state, increment;
+        uint64_t initialSeed, position;
+
+    public:
+        typedef uint32_t result_type;
+
+        Pcg32();
+        void seed(uint64_t seed);
+        void advance(uint64_t delta);
+        void restore(uint64_t seed, uint64_t position);
+        uint64_t getSeed();
+        uint64_t getPosition();
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT32_MAX; }
+
+        result_type operator()()
+        {
+            uint64_t oldState = this->state;
+            this->state = oldState * 6364136223846793005ULL + this->increment;
+            this->position++;
+            uint32_t xorShifted = ((oldState >> 18) ^ oldState) >> 27;
+            uint32_t rotation = oldState >> 59;
+            return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+        }
+};
+
+#endif
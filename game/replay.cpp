@@ -0,0 +1,470 @@
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <climits>
+#include "replay.h"
+#include "game.h"
+
+using std::to_string;
+
+static const char replayMagic[4] = {'A', 'V', 'Z', 'R'};
+static const int replayVersion = 1;
+
+ReplayRecorder::ReplayRecorder()
+{
+}
+
+void ReplayRecorder::writeVarint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        this->bytes.push_back((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    this->bytes.push_back(value);
+}
+
+// Zigzag, so small negative numbers stay small
+void ReplayRecorder::writeInt(int value)
+{
+    this->writeVarint(((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+// Same fields as a save file
+void ReplayRecorder::writeState(GameState& state)
+{
+    this->writeVarint(state.rows);
+    this->writeVarint(state.cols);
+    for(int i = 0; i < state.rows; i++)
+    {
+        for(int j = 0; j < state.cols; j++)
+        {
+            this->bytes.push_back(state.board.get(i, j));
+        }
+    }
+
+    for(int i = 0; i < 5; i++)
+    {
+        this->writeInt(state.alienAttributes[i]);
+    }
+    this->writeVarint(state.numberOfZombies);
+    for(int i = 0; i < state.numberOfZombies; i++)
+    {
+        for(int j = 0; j < 6; j++)
+        {
+            this->writeInt(state.zombieAttributes[i][j]);
+        }
+    }
+
+    this->writeInt(state.numberOfPlayerTurns);
+    this->writeInt(state.healthLost);
+    this->writeInt(state.attackGained);
+    this->writeVarint(state.randomSeed);
+    this->writeVarint(state.randomPosition);
+}
+
+void ReplayRecorder::writeEvents(const vector<GameEvent>& events)
+{
+    this->writeVarint(events.size());
+    for(int i = 0; i < (int)events.size(); i++)
+    {
+        this->writeVarint(events[i].type);
+        this->writeVarint(events[i].zombieID);
+        this->writeInt(events[i].amount);
+        this->writeVarint(events[i].coordinates.first);
+        this->writeVarint(events[i].coordinates.second);
+    }
+}
+
+// Start recording from where game is now
+void ReplayRecorder::start(Game& game)
+{
+    this->bytes.clear();
+    for(int i = 0; i < 4; i++)
+    {
+        this->bytes.push_back(replayMagic[i]);
+    }
+    this->writeVarint(replayVersion);
+
+    GameState state = game.getGameState();
+    this->writeState(state);
+}
+
+// events are everything the move caused, from beginAlienMove until stepMove returned false
+void ReplayRecorder::alienMove(int direction, const vector<GameEvent>& events)
+{
+    this->writeVarint(REPLAY_ALIEN_MOVE);
+    this->writeVarint(direction);
+    this->writeEvents(events);
+}
+
+void ReplayRecorder::zombieMove(int id, int direction, const vector<GameEvent>& events)
+{
+    this->writeVarint(REPLAY_ZOMBIE_MOVE);
+    this->writeVarint(id);
+    this->writeInt(direction);
+    this->writeEvents(events);
+}
+
+void ReplayRecorder::arrowChange(pair<int,int> coordinates, int direction)
+{
+    this->writeVarint(REPLAY_ARROW);
+    this->writeVarint(coordinates.first);
+    this->writeVarint(coordinates.second);
+    this->writeVarint(direction);
+}
+
+void ReplayRecorder::energyGained()
+{
+    this->writeVarint(REPLAY_ENERGY);
+}
+
+void ReplayRecorder::nextTurn()
+{
+    this->writeVarint(REPLAY_NEXT_TURN);
+}
+
+void ReplayRecorder::checkpoint()
+{
+    this->writeVarint(REPLAY_CHECKPOINT);
+}
+
+void ReplayRecorder::undo()
+{
+    this->writeVarint(REPLAY_UNDO);
+}
+
+void ReplayRecorder::redo()
+{
+    this->writeVarint(REPLAY_REDO);
+}
+
+// Close the replay with the state game ended in, won, lost or quit
+void ReplayRecorder::finish(Game& game)
+{
+    this->writeVarint(REPLAY_END);
+    GameState state = game.getGameState();
+    this->writeState(state);
+}
+
+// Write the finished replay to path, making its directory if needed
+bool ReplayRecorder::save(const string& path)
+{
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    std::error_code error;
+    if (!directory.empty()) std::filesystem::create_directories(directory, error);
+
+    std::ofstream replayFile(path, std::ios::binary);
+    replayFile.write((const char*)this->bytes.data(), this->bytes.size());
+    return (bool)replayFile;
+}
+
+const vector<uint8_t>& ReplayRecorder::getBytes()
+{
+    return this->bytes;
+}
+
+// Reads a replay back, any read past the end or out of range marks it broken instead of crashing
+struct ReplayReader
+{
+    const vector<uint8_t>& bytes;
+    int position;
+    bool broken;
+
+    ReplayReader(const vector<uint8_t>& bytes) : bytes(bytes), position(0), broken(false) {}
+
+    uint64_t readVarint()
+    {
+        uint64_t value = 0;
+        for(int shift = 0; shift < 64; shift += 7)
+        {
+            if (this->position >= (int)this->bytes.size())
+            {
+                this->broken = true;
+                return 0;
+            }
+            uint8_t byte = this->bytes[this->position++];
+            value |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        this->broken = true;
+        return 0;
+    }
+
+    // Unsigned value that has to be below limit
+    int readBelow(int limit)
+    {
+        uint64_t value = this->readVarint();
+        if (value >= (uint64_t)limit)
+        {
+            this->broken = true;
+            return 0;
+        }
+        return value;
+    }
+
+    int readInt()
+    {
+        uint32_t value = this->readVarint();
+        return (int)(value >> 1) ^ -(int)(value & 1);
+    }
+
+    static bool inside(GameState& state, int row, int col)
+    {
+        return row >= 0 && row < state.rows && col >= 0 && col < state.cols;
+    }
+
+    bool readState(GameState& state)
+    {
+        // Anything bigger can't be a board the game made
+        state.rows = this->readBelow(10000);
+        state.cols = this->readBelow(10000);
+        if (this->broken || (long long)state.rows * state.cols > (long long)this->bytes.size() - this->position) return false;
+        state.board.resize(state.rows, state.cols);
+        for(int i = 0; i < state.rows; i++)
+        {
+            for(int j = 0; j < state.cols; j++)
+            {
+                state.board.set(i, j, this->bytes[this->position++]);
+            }
+        }
+
+        state.alienAttributes.resize(5);
+        for(int i = 0; i < 5; i++)
+        {
+            state.alienAttributes[i] = this->readInt();
+        }
+        state.numberOfZombies = this->readBelow(state.rows * state.cols);
+        state.zombieAttributes.assign(state.numberOfZombies, vector<int> (6));
+        for(int i = 0; i < state.numberOfZombies && !this->broken; i++)
+        {
+            for(int j = 0; j < 6; j++)
+            {
+                state.zombieAttributes[i][j] = this->readInt();
+            }
+        }
+
+        state.numberOfPlayerTurns = this->readInt();
+        state.healthLost = this->readInt();
+        state.attackGained = this->readInt();
+        state.randomSeed = this->readVarint();
+        state.randomPosition = this->readVarint();
+        if (this->broken) return false;
+
+        // Game::loadGame trusts that the characters and the board agree
+        if (!inside(state, state.alienAttributes[0], state.alienAttributes[1])) return false;
+        if (state.board.get(state.alienAttributes[0], state.alienAttributes[1]) != 'A') return false;
+        vector<char> hasZombie(state.rows * state.cols, 0);
+        for(int i = 0; i < state.numberOfZombies; i++)
+        {
+            int row = state.zombieAttributes[i][1], col = state.zombieAttributes[i][2];
+            if (state.zombieAttributes[i][0] != i + 1 || !inside(state, row, col)) return false;
+            bool onZombieCell = state.board.checkCell(row, col) == 9;
+            if (state.zombieAttributes[i][3] > 0 && !onZombieCell) return false;
+            if (onZombieCell) hasZombie[row * state.cols + col] = 1;
+        }
+        for(int i = 0; i < state.rows; i++)
+        {
+            for(int j = 0; j < state.cols; j++)
+            {
+                if (state.board.checkCell(i, j) == 9 && !hasZombie[i * state.cols + j]) return false;
+            }
+        }
+        return true;
+    }
+
+    // True if the next events in the replay are exactly events
+    bool readEvents(const vector<GameEvent>& events, int& numOfEvents)
+    {
+        numOfEvents = this->readVarint();
+        if (this->broken || numOfEvents != (int)events.size()) return false;
+        for(int i = 0; i < numOfEvents; i++)
+        {
+            int type = this->readVarint();
+            int zombieID = this->readVarint();
+            int amount = this->readInt();
+            int row = this->readVarint();
+            int col = this->readVarint();
+            if (this->broken) return false;
+            if (type != events[i].type || zombieID != events[i].zombieID || amount != events[i].amount ||
+                row != events[i].coordinates.first || col != events[i].coordinates.second) return false;
+        }
+        return true;
+    }
+};
+
+// Name of the first field that differs, empty if the states are the same
+static string firstDifference(GameState& a, GameState& b)
+{
+    if (a.rows != b.rows || a.cols != b.cols) return "board size";
+    for(int i = 0; i < a.rows; i++)
+    {
+        for(int j = 0; j < a.cols; j++)
+        {
+            if (a.board.get(i, j) != b.board.get(i, j)) return "board cell " + to_string(i) + "," + to_string(j);
+        }
+    }
+    if (a.alienAttributes != b.alienAttributes) return "alien";
+    if (a.numberOfZombies != b.numberOfZombies) return "number of zombies";
+    for(int i = 0; i < a.numberOfZombies; i++)
+    {
+        if (a.zombieAttributes[i] != b.zombieAttributes[i]) return "zombie " + to_string(i + 1);
+    }
+    if (a.numberOfPlayerTurns != b.numberOfPlayerTurns) return "player turns";
+    if (a.healthLost != b.healthLost || a.attackGained != b.attackGained) return "health lost or attack gained";
+    if (a.randomSeed != b.randomSeed || a.randomPosition != b.randomPosition) return "random engine";
+    return "";
+}
+
+// Play a replay file again without the display
+ReplayResult Replays::playReplay(const string& path)
+{
+    std::ifstream replayFile(path, std::ios::binary);
+    if (!replayFile.is_open())
+    {
+        ReplayResult result;
+        result.matches = false;
+        result.error = "can't open " + path;
+        result.commands = result.events = 0;
+        return result;
+    }
+    vector<uint8_t> bytes((std::istreambuf_iterator<char>(replayFile)), std::istreambuf_iterator<char>());
+    return Replays::playReplay(bytes);
+}
+
+// Start from the recorded GameState and give the Game every recorded command in order
+// Stops at the first command that can't be given, or that causes different events from the recorded ones
+ReplayResult Replays::playReplay(const vector<uint8_t>& bytes)
+{
+    ReplayResult result;
+    result.matches = false;
+    result.commands = result.events = 0;
+
+    ReplayReader reader(bytes);
+    if (bytes.size() < 4 || !std::equal(replayMagic, replayMagic + 4, bytes.begin()))
+    {
+        result.error = "not a replay";
+        return result;
+    }
+    reader.position = 4;
+    if (reader.readVarint() != replayVersion)
+    {
+        result.error = "unknown replay version";
+        return result;
+    }
+
+    GameState state;
+    if (!reader.readState(state))
+    {
+        result.error = "broken starting state";
+        return result;
+    }
+
+    // Undo only ever goes back a checkpoint at a time, so keeping every one gives the same game as any smaller limit
+    Game game;
+    game.setUndoLimit(INT_MAX);
+    game.loadGame(state);
+    vector<GameEvent> events;
+
+    while (true)
+    {
+        int command = reader.readVarint();
+        if (reader.broken)
+        {
+            result.error = "replay ends without the final state";
+            return result;
+        }
+        if (command == REPLAY_END) break;
+
+        string commandName = "command " + to_string(result.commands + 1);
+        events.clear();
+        int numOfEvents = 0;
+        bool valid = true;
+        if (command == REPLAY_ALIEN_MOVE)
+        {
+            int direction = reader.readBelow(4);
+            valid = !reader.broken && !game.gameOver && game.getCurrentTurn() == 0;
+            if (valid)
+            {
+                game.applyAlienMove(direction, events);
+                valid = reader.readEvents(events, numOfEvents);
+            }
+        }
+        else if (command == REPLAY_ZOMBIE_MOVE)
+        {
+            int id = reader.readVarint();
+            int direction = reader.readInt();
+            valid = !reader.broken && !game.gameOver && id >= 1 && game.getCurrentTurn() == id;
+            // Drawing the direction again keeps the random engine in step, and checks it
+            if (valid) valid = game.getRandomZombieDirection(id) == direction;
+            if (valid)
+            {
+                game.applyZombieMove(id, direction, events);
+                valid = reader.readEvents(events, numOfEvents);
+            }
+        }
+        else if (command == REPLAY_ARROW)
+        {
+            pair<int,int> coordinates;
+            coordinates.first = reader.readBelow(state.rows);
+            coordinates.second = reader.readBelow(state.cols);
+            int direction = reader.readBelow(4);
+            int coordinatesCode = game.checkCoordinate(coordinates, 4);
+            valid = !reader.broken && coordinatesCode >= 0 && coordinatesCode <= 3 && game.alien.getEnergy() > 0;
+            if (valid)
+            {
+                game.changeArrowDirection(coordinates, direction);
+                game.alien.decEnergy();
+            }
+        }
+        else if (command == REPLAY_ENERGY)
+        {
+            game.alien.incEnergy();
+        }
+        else if (command == REPLAY_NEXT_TURN)
+        {
+            game.nextTurn();
+        }
+        else if (command == REPLAY_CHECKPOINT)
+        {
+            game.checkpoint();
+        }
+        else if (command == REPLAY_UNDO)
+        {
+            valid = game.undo();
+        }
+        else if (command == REPLAY_REDO)
+        {
+            valid = game.redo();
+        }
+        else
+        {
+            valid = false;
+        }
+
+        if (!valid)
+        {
+            result.error = commandName + " can't be replayed or caused different events";
+            return result;
+        }
+        result.commands++;
+        result.events += numOfEvents;
+    }
+
+    GameState recordedState;
+    if (!reader.readState(recordedState))
+    {
+        result.error = "broken final state";
+        return result;
+    }
+
+    result.finalState = game.getGameState();
+    string difference = firstDifference(result.finalState, recordedState);
+    if (!difference.empty())
+    {
+        result.error = "final state differs at " + difference;
+        return result;
+    }
+    result.matches = true;
+    return result;
+}
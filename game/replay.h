@@ -0,0 +1,88 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "game_state.h"
+#include "game_event.h"
+
+using std::vector;
+using std::string;
+
+class Game;
+
+/*
+    Binary replay of a game, enough to play it again exactly
+
+    The file starts with "AVZR", the version and the GameState the game started from (which includes the
+    random engine's seed and position), then one record per command with the events it caused, then the
+    final GameState. Numbers are LEB128 varints, signed ones zigzag encoded first, so most take one byte
+*/
+enum ReplayCommand
+{
+    // No more commands, the final GameState follows
+    REPLAY_END,
+    // Alien slid in direction
+    REPLAY_ALIEN_MOVE,
+    // Zombie id moved in the direction Game::getRandomZombieDirection drew for it, -1 if it passed
+    REPLAY_ZOMBIE_MOVE,
+    // Arrow at row, col turned to direction, costing the alien one energy
+    REPLAY_ARROW,
+    // Alien gained energy at the start of its turn
+    REPLAY_ENERGY,
+    // Game::nextTurn
+    REPLAY_NEXT_TURN,
+    // Game::checkpoint
+    REPLAY_CHECKPOINT,
+    // Game::undo, only recorded if it undid something
+    REPLAY_UNDO,
+    // Game::redo, only recorded if it redid something
+    REPLAY_REDO
+};
+
+// Records a game as it is played, the caller reports every command it gives the Game
+// The replay is kept in memory, save writes it out once it is finished
+class ReplayRecorder
+{
+    private:
+        vector<uint8_t> bytes;
+
+        void writeVarint(uint64_t value);
+        void writeInt(int value);
+        void writeState(GameState& state);
+        void writeEvents(const vector<GameEvent>& events);
+
+    public:
+        ReplayRecorder();
+        void start(Game& game);
+        void alienMove(int direction, const vector<GameEvent>& events);
+        void zombieMove(int id, int direction, const vector<GameEvent>& events);
+        void arrowChange(pair<int,int> coordinates, int direction);
+        void energyGained();
+        void nextTurn();
+        void checkpoint();
+        void undo();
+        void redo();
+        void finish(Game& game);
+        bool save(const string& path);
+        const vector<uint8_t>& getBytes();
+};
+
+struct ReplayResult
+{
+    // The replay was read to the end, every command caused the recorded events and the final GameState matched
+    bool matches;
+    // What went wrong when it doesn't match
+    string error;
+    int commands, events;
+    GameState finalState;
+};
+
+namespace Replays
+{
+    ReplayResult playReplay(const string& path);
+    ReplayResult playReplay(const vector<uint8_t>& bytes);
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "threat_map.h"
+#include <algorithm>
+
+ThreatMap::ThreatMap()
+{
+    this->rows = 0;
+    this->cols = 0;
+}
+
+// Size the map for a board with no zombies on it
+void ThreatMap::resize(int rows, int cols)
+{
+    this->rows = rows;
+    this->cols = cols;
+    this->threat.assign(rows * cols, 0);
+}
+
+// Add sign * attack to every cell the zombie has in range
+// Only the square around the zombie can be in range, so only that is visited
+void ThreatMap::addRange(Zombie& zombie, int sign)
+{
+    pair<int,int> coordinates = zombie.getCoordinates();
+    int range = zombie.getRange();
+    int attack = sign * zombie.getAttack();
+
+    int firstRow = std::max(0, coordinates.first - range);
+    int lastRow = std::min(this->rows - 1, coordinates.first + range);
+    int firstCol = std::max(0, coordinates.second - range);
+    int lastCol = std::min(this->cols - 1, coordinates.second + range);
+    for(int row = firstRow; row <= lastRow; row++)
+    {
+        for(int col = firstCol; col <= lastCol; col++)
+        {
+            pair<int,int> cell = {row, col};
+            if (zombie.isInRange(cell)) this->threat[row * this->cols + col] += attack;
+        }
+    }
+}
+
+void ThreatMap::addZombie(Zombie& zombie)
+{
+    this->addRange(zombie, 1);
+}
+
+void ThreatMap::removeZombie(Zombie& zombie)
+{
+    this->addRange(zombie, -1);
+}
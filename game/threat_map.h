@@ -0,0 +1,33 @@
+#ifndef THREAT_MAP_H
+#define THREAT_MAP_H
+
+#include <vector>
+#include "characters/zombie.h"
+
+using std::vector;
+
+// Total attack of the living zombies that have each cell in range
+// Kept up to date as zombies move and die, so the damage waiting on a cell is a single lookup
+class ThreatMap
+{
+    private:
+        int rows, cols;
+        // Row-major, same layout as Board
+        vector<int> threat;
+
+        void addRange(Zombie& zombie, int sign);
+
+    public:
+        ThreatMap();
+        void resize(int rows, int cols);
+        void addZombie(Zombie& zombie);
+        void removeZombie(Zombie& zombie);
+        int get(int row, int col) const;
+};
+
+inline int ThreatMap::get(int row, int col) const
+{
+    return this->threat[row * this->cols + col];
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "transposition_table.h"
+
+// splitmix64 finalizer
+uint64_t Zobrist::mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Toggled when the search walks over an arrow and clears it
+uint64_t Zobrist::clearedCellKey(int cellIndex)
+{
+    return mix(0x636c656172ULL ^ (uint64_t)cellIndex);
+}
+
+// Toggled out and in whenever a zombie's health changes in the search
+uint64_t Zobrist::zombieHealthKey(int zombieIndex, int health)
+{
+    return mix(((uint64_t)zombieIndex << 32) ^ (uint32_t)health);
+}
+
+// Combine the incremental board/zombie hash with what changes on every step
+uint64_t Zobrist::nodeKey(uint64_t stateHash, int row, int col, int direction, int energyLeft, int attackDealt, int attackGain)
+{
+    uint64_t key = mix(((uint64_t)(uint32_t)row << 32) ^ ((uint64_t)(uint32_t)col << 4) ^ (uint64_t)(direction & 15));
+    key = mix(key ^ ((uint64_t)(uint32_t)energyLeft << 48) ^ (uint64_t)(uint32_t)attackDealt);
+    key = mix(key ^ (uint64_t)(uint32_t)attackGain);
+    return stateHash ^ key;
+}
+
+// Table is empty until resized, so a Game that never asks for a hint pays nothing
+TranspositionTable::TranspositionTable()
+{
+    this->mask = 0;
+    this->generation = 0;
+}
+
+void TranspositionTable::resize(int log2Size)
+{
+    this->entries.assign((std::size_t)1 << log2Size, TranspositionEntry());
+    this->mask = ((uint64_t)1 << log2Size) - 1;
+    this->generation = 1;
+}
+
+bool TranspositionTable::isEmpty()
+{
+    return this->entries.empty();
+}
+
+// Start a new generation instead of touching every entry
+void TranspositionTable::clear()
+{
+    this->generation++;
+    if (this->generation == 0)
+    {
+        // Wrapped around, old entries could look current again
+        this->entries.assign(this->entries.size(), TranspositionEntry());
+        this->generation = 1;
+    }
+}
+
+// Allocate on first use, otherwise just empty the table
+void TranspositionTable::prepare(int log2Size)
+{
+    if (this->isEmpty())
+    {
+        this->resize(log2Size);
+    }
+    else
+    {
+        this->clear();
+    }
+}
+
+// Return the entry for key, or nullptr if it is not stored
+TranspositionEntry* TranspositionTable::probe(uint64_t key)
+{
+    TranspositionEntry& entry = this->entries[key & this->mask];
+    if (entry.generation == this->generation && entry.key == key) return &entry;
+    return nullptr;
+}
+
+// Return the entry key would be stored in, replacing whatever is there
+TranspositionEntry& TranspositionTable::slot(uint64_t key)
+{
+    TranspositionEntry& entry = this->entries[key & this->mask];
+    entry.key = key;
+    entry.generation = this->generation;
+    return entry;
+}
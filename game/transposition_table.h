@@ -0,0 +1,51 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "hint_types.h"
+
+using std::vector;
+
+// Zobrist-style keys for the hint search state
+// Keys are derived by mixing instead of being stored, so any board size or zombie count works
+namespace Zobrist
+{
+    uint64_t mix(uint64_t x);
+    uint64_t clearedCellKey(int cellIndex);
+    uint64_t zombieHealthKey(int zombieIndex, int health);
+    uint64_t nodeKey(uint64_t stateHash, int row, int col, int direction, int energyLeft, int attackDealt, int attackGain);
+}
+
+// Best result of a subtree, relative to the node it was stored at
+struct TranspositionEntry
+{
+    uint64_t key;
+    // Entry is only valid while it matches the table's generation
+    uint32_t generation;
+    MoveDetails bestDetails;
+    // Arrows changed inside the subtree, in order
+    ArrowChange arrows[maxArrowChanges];
+    int numOfArrows;
+};
+
+// Fixed-size, always-replace table
+class TranspositionTable
+{
+    private:
+        vector<TranspositionEntry> entries;
+        uint64_t mask;
+        uint32_t generation;
+
+    public:
+        TranspositionTable();
+        void resize(int log2Size);
+        bool isEmpty();
+        void clear();
+        void prepare(int log2Size);
+        TranspositionEntry* probe(uint64_t key);
+        TranspositionEntry& slot(uint64_t key);
+};
+
+#endif
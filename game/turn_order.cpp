@@ -0,0 +1,72 @@
+#include "turn_order.h"
+
+TurnOrder::TurnOrder()
+{
+    this->reset(0);
+}
+
+// Alien and every zombie, the alien goes first
+void TurnOrder::reset(int numOfZombies)
+{
+    int numOfActors = numOfZombies + 1;
+    this->next.resize(numOfActors);
+    this->prev.resize(numOfActors);
+    this->linked.assign(numOfActors, 1);
+    for(int id = 0; id < numOfActors; id++)
+    {
+        this->next[id] = (id + 1) % numOfActors;
+        this->prev[id] = (id + numOfActors - 1) % numOfActors;
+    }
+    this->current = 0;
+    this->currentRemoved = false;
+}
+
+// Take a zombie out of the order, when it dies
+void TurnOrder::remove(int id)
+{
+    if (!this->linked[id]) return;
+
+    this->next[this->prev[id]] = this->next[id];
+    this->prev[this->next[id]] = this->prev[id];
+    this->linked[id] = 0;
+
+    if (id == this->current)
+    {
+        this->current = this->next[id];
+        this->currentRemoved = true;
+    }
+}
+
+// Put a removed zombie back where it was, removals have to be undone in the reverse order they were made
+// remove leaves the zombie's own links alone, so they still point at its old neighbours
+void TurnOrder::restore(int id)
+{
+    if (this->linked[id]) return;
+
+    this->next[this->prev[id]] = id;
+    this->prev[this->next[id]] = id;
+    this->linked[id] = 1;
+}
+
+// The current actor's turn is over
+void TurnOrder::advance()
+{
+    if (this->currentRemoved)
+    {
+        this->currentRemoved = false;
+        return;
+    }
+    this->current = this->next[this->current];
+}
+
+// The count actors after the current one, in turn order, wrapping around as many times as it takes
+void TurnOrder::peek(int count, vector<int>& actors) const
+{
+    actors.clear();
+    int id = this->currentRemoved ? this->prev[this->current] : this->current;
+    for(int i = 0; i < count; i++)
+    {
+        id = this->next[id];
+        actors.push_back(id);
+    }
+}
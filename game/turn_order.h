@@ -0,0 +1,65 @@
+#ifndef TURN_ORDER_H
+#define TURN_ORDER_H
+
+#include <vector>
+
+using std::vector;
+
+// Where a TurnOrder is up to, enough to put it back there
+struct TurnPosition
+{
+    int current;
+    bool currentRemoved;
+};
+
+/*
+    Whose turn it is, 0 = Alien, >= 1 = Zombie's ID
+
+    Actors still in the game form a circular linked list through next and prev, in ID order
+    Taking a dead zombie out, moving to the next turn and asking for the current one are all O(1),
+    and nothing allocates after reset
+*/
+class TurnOrder
+{
+    private:
+        vector<int> next, prev;
+        vector<char> linked;
+        int current;
+        // The current actor was removed during its turn, current already points at the one after it
+        bool currentRemoved;
+
+    public:
+        TurnOrder();
+        void reset(int numOfZombies);
+        void remove(int id);
+        void restore(int id);
+        void advance();
+        int getCurrent() const;
+        bool contains(int id) const;
+        void peek(int count, vector<int>& actors) const;
+        TurnPosition getPosition() const;
+        void setPosition(TurnPosition position);
+};
+
+inline int TurnOrder::getCurrent() const
+{
+    return this->current;
+}
+
+inline bool TurnOrder::contains(int id) const
+{
+    return this->linked[id];
+}
+
+inline TurnPosition TurnOrder::getPosition() const
+{
+    return {this->current, this->currentRemoved};
+}
+
+inline void TurnOrder::setPosition(TurnPosition position)
+{
+    this->current = position.current;
+    this->currentRemoved = position.currentRemoved;
+}
+
+#endif
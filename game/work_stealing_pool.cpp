@@ -0,0 +1,124 @@
+#include "work_stealing_pool.h"
+
+// Which pool and worker the current thread belongs to
+static thread_local WorkStealingPool* currentPool = nullptr;
+static thread_local int currentIndex = 0;
+
+WorkStealingPool::WorkStealingPool(int numOfWorkers)
+{
+    if (numOfWorkers < 1) numOfWorkers = 1;
+    this->queuedTasks = 0;
+    this->stopping = false;
+
+    for(int i = 0; i < numOfWorkers; i++)
+    {
+        this->workers.push_back(std::make_unique<Worker>());
+    }
+
+    // Worker 0 is whoever calls wait()
+    for(int i = 1; i < numOfWorkers; i++)
+    {
+        this->threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(this->idleLock);
+        this->stopping = true;
+    }
+    this->idle.notify_all();
+    for(int i = 0; i < (int)this->threads.size(); i++)
+    {
+        this->threads[i].join();
+    }
+}
+
+int WorkStealingPool::getNumOfWorkers()
+{
+    return this->workers.size();
+}
+
+// Index of the worker running on this thread, threads outside the pool count as worker 0
+int WorkStealingPool::currentWorker()
+{
+    return currentPool == this ? currentIndex : 0;
+}
+
+void WorkStealingPool::workerLoop(int index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    while (true)
+    {
+        if (this->runOne(index)) continue;
+
+        std::unique_lock<std::mutex> guard(this->idleLock);
+        this->idle.wait(guard, [this]() { return this->stopping || this->queuedTasks > 0; });
+        if (this->stopping) return;
+    }
+}
+
+// Run one task, own deque first and then steal from the others
+// Return false if there was nothing to run
+bool WorkStealingPool::runOne(int index)
+{
+    std::function<void()> task;
+    int numOfWorkers = this->workers.size();
+
+    for(int i = 0; i < numOfWorkers && !task; i++)
+    {
+        Worker& worker = *this->workers[(index + i) % numOfWorkers];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        if (worker.tasks.empty()) continue;
+
+        if (i == 0)
+        {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        }
+    }
+
+    if (!task) return false;
+
+    this->queuedTasks--;
+    task();
+    return true;
+}
+
+void WorkStealingPool::spawn(TaskGroup& group, std::function<void()> task)
+{
+    group.pending++;
+    Worker& worker = *this->workers[this->currentWorker()];
+    {
+        std::lock_guard<std::mutex> guard(worker.lock);
+        worker.tasks.push_back([&group, task]()
+        {
+            task();
+            group.pending--;
+        });
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(this->idleLock);
+        this->queuedTasks++;
+    }
+    this->idle.notify_one();
+}
+
+// Keep running tasks until every task in the group is done
+void WorkStealingPool::wait(TaskGroup& group)
+{
+    int index = this->currentWorker();
+    while (group.pending > 0)
+    {
+        if (!this->runOne(index)) std::this_thread::yield();
+    }
+}
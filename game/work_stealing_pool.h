@@ -0,0 +1,52 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+
+using std::vector;
+
+// Tasks spawned together, waited on together
+struct TaskGroup
+{
+    std::atomic<int> pending {0};
+};
+
+// Fork-join pool where every worker owns a deque of tasks
+// A worker pops its own newest task first and steals the oldest task of another worker when it runs out
+// The thread that calls wait() works as worker 0, so it helps instead of blocking
+class WorkStealingPool
+{
+    private:
+        struct Worker
+        {
+            std::deque<std::function<void()>> tasks;
+            std::mutex lock;
+        };
+
+        vector<std::unique_ptr<Worker>> workers;
+        vector<std::thread> threads;
+        std::mutex idleLock;
+        std::condition_variable idle;
+        std::atomic<int> queuedTasks;
+        std::atomic<bool> stopping;
+
+        void workerLoop(int index);
+        bool runOne(int index);
+
+    public:
+        WorkStealingPool(int numOfWorkers);
+        ~WorkStealingPool();
+        int getNumOfWorkers();
+        int currentWorker();
+        void spawn(TaskGroup& group, std::function<void()> task);
+        void wait(TaskGroup& group);
+};
+
+#endif
@@ -0,0 +1,52 @@
+#include "zombie_grid.h"
+
+ZombieGrid::ZombieGrid()
+{
+    this->rows = 0;
+    this->cols = 0;
+    this->bucketRows = 0;
+    this->bucketCols = 0;
+}
+
+// Size the grid for a board with no zombies on it yet
+void ZombieGrid::reset(int rows, int cols, int numOfZombies)
+{
+    this->rows = rows;
+    this->cols = cols;
+    this->bucketRows = (rows + bucketSize - 1) / bucketSize;
+    this->bucketCols = (cols + bucketSize - 1) / bucketSize;
+    this->buckets.assign(this->bucketRows * this->bucketCols, vector<int>());
+    this->positions.assign(numOfZombies, {-1, -1});
+}
+
+void ZombieGrid::add(int index, pair<int,int> coord)
+{
+    this->positions[index] = coord;
+    this->buckets[this->bucketOf(coord)].push_back(index);
+}
+
+// Take a zombie out of the grid, when it dies
+void ZombieGrid::remove(int index)
+{
+    vector<int>& bucket = this->buckets[this->bucketOf(this->positions[index])];
+    for(int i = 0; i < (int)bucket.size(); i++)
+    {
+        if (bucket[i] != index) continue;
+        bucket[i] = bucket.back();
+        bucket.pop_back();
+        break;
+    }
+    this->positions[index] = {-1, -1};
+}
+
+// Zombie moved to coord, most moves stay in the same bucket
+void ZombieGrid::move(int index, pair<int,int> coord)
+{
+    if (this->bucketOf(coord) == this->bucketOf(this->positions[index]))
+    {
+        this->positions[index] = coord;
+        return;
+    }
+    this->remove(index);
+    this->add(index, coord);
+}
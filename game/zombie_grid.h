@@ -0,0 +1,132 @@
+#ifndef ZOMBIE_GRID_H
+#define ZOMBIE_GRID_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using std::vector;
+using std::pair;
+
+// Uniform grid over the board, each bucket lists the zombies (0-indexed) standing in its bucketSize x bucketSize cells
+// Kept up to date as zombies move and die, so nearest and in-range queries only visit the buckets around a cell
+// Distances are squared, the same as Game::getClosestZombies
+class ZombieGrid
+{
+    private:
+        static const int bucketSize = 8;
+        int rows, cols, bucketRows, bucketCols;
+        vector<vector<int>> buckets;
+        // Where each zombie is, {-1, -1} once it has left the grid
+        vector<pair<int,int>> positions;
+
+        int bucketOf(pair<int,int> coord) const;
+        static int distance(pair<int,int> a, pair<int,int> b);
+
+    public:
+        ZombieGrid();
+        void reset(int rows, int cols, int numOfZombies);
+        void add(int index, pair<int,int> coord);
+        void remove(int index);
+        void move(int index, pair<int,int> coord);
+        bool contains(int index) const;
+        pair<int,int> getPosition(int index) const;
+
+        template <typename Skip>
+        int closestDistance(pair<int,int> coord, Skip skip) const;
+        template <typename Skip>
+        void within(pair<int,int> coord, int squaredRadius, Skip skip, vector<int>& result) const;
+};
+
+inline int ZombieGrid::bucketOf(pair<int,int> coord) const
+{
+    return (coord.first / bucketSize) * this->bucketCols + coord.second / bucketSize;
+}
+
+inline int ZombieGrid::distance(pair<int,int> a, pair<int,int> b)
+{
+    return (a.first - b.first) * (a.first - b.first) + (a.second - b.second) * (a.second - b.second);
+}
+
+inline bool ZombieGrid::contains(int index) const
+{
+    return this->positions[index].first != -1;
+}
+
+inline pair<int,int> ZombieGrid::getPosition(int index) const
+{
+    return this->positions[index];
+}
+
+// Squared distance from coord to the closest zombie skip(index) doesn't rule out, INT_MAX if there is none
+// Buckets are visited in rings around coord's bucket, stopping once a whole ring is too far to beat the best so far
+template <typename Skip>
+int ZombieGrid::closestDistance(pair<int,int> coord, Skip skip) const
+{
+    int best = INT_MAX;
+    int bucketRow = coord.first / bucketSize, bucketCol = coord.second / bucketSize;
+    int rings = std::max(this->bucketRows, this->bucketCols);
+    for(int ring = 0; ring < rings; ring++)
+    {
+        // Every cell of ring r is at least (r - 1) * bucketSize + 1 rows or columns away
+        if (ring > 0)
+        {
+            long long gap = (long long)(ring - 1) * bucketSize + 1;
+            if (gap * gap > best) break;
+        }
+
+        int firstRow = std::max(0, bucketRow - ring), lastRow = std::min(this->bucketRows - 1, bucketRow + ring);
+        int firstCol = std::max(0, bucketCol - ring), lastCol = std::min(this->bucketCols - 1, bucketCol + ring);
+        for(int row = firstRow; row <= lastRow; row++)
+        {
+            bool edgeRow = row == bucketRow - ring || row == bucketRow + ring;
+            for(int col = firstCol; col <= lastCol; col++)
+            {
+                // Between the top and bottom edges of the ring only its left and right edges are new
+                if (!edgeRow && col > bucketCol - ring && col < bucketCol + ring)
+                {
+                    col = bucketCol + ring - 1;
+                    continue;
+                }
+                const vector<int>& bucket = this->buckets[row * this->bucketCols + col];
+                for(int i = 0; i < (int)bucket.size(); i++)
+                {
+                    if (skip(bucket[i])) continue;
+                    best = std::min(best, distance(coord, this->positions[bucket[i]]));
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// Append every zombie skip(index) doesn't rule out within squaredRadius of coord to result, in index order
+// Only what was appended is sorted, result can hold the callers' own entries before it
+template <typename Skip>
+void ZombieGrid::within(pair<int,int> coord, int squaredRadius, Skip skip, vector<int>& result) const
+{
+    int start = result.size();
+    int radius = std::sqrt((double)squaredRadius);
+    while ((long long)(radius + 1) * (radius + 1) <= squaredRadius) radius++;
+    while ((long long)radius * radius > squaredRadius) radius--;
+
+    int firstRow = std::max(0, coord.first - radius) / bucketSize, lastRow = std::min(this->rows - 1, coord.first + radius) / bucketSize;
+    int firstCol = std::max(0, coord.second - radius) / bucketSize, lastCol = std::min(this->cols - 1, coord.second + radius) / bucketSize;
+    for(int row = firstRow; row <= lastRow; row++)
+    {
+        for(int col = firstCol; col <= lastCol; col++)
+        {
+            const vector<int>& bucket = this->buckets[row * this->bucketCols + col];
+            for(int i = 0; i < (int)bucket.size(); i++)
+            {
+                if (skip(bucket[i]) || distance(coord, this->positions[bucket[i]]) > squaredRadius) continue;
+                result.push_back(bucket[i]);
+            }
+        }
+    }
+    std::sort(result.begin() + start, result.end());
+}
+
+#endif
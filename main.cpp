@@ -1,8 +1,32 @@
+#include <iostream>
+#include <string>
 #include "controller.h"
 
-int main()
+// alien_vs_zombies [terminal]   draws the game on the terminal
+// alien_vs_zombies null         shows no frames, only the menus and prompts (eg. to script games)
+// alien_vs_zombies record file  writes every frame to file instead of drawing it
+int main(int argc, char* argv[])
 {
-    Controller controller;
-    controller.mainMenu();    
+    std::string renderer = argc > 1 ? argv[1] : "terminal";
+    if (renderer == "null")
+    {
+        Controller<NullRenderer> controller;
+        controller.mainMenu();
+    }
+    else if (renderer == "record")
+    {
+        Controller<RecordingRenderer> controller(RecordingRenderer(argc > 2 ? argv[2] : "frames.txt"));
+        controller.mainMenu();
+    }
+    else if (renderer == "terminal")
+    {
+        Controller<TerminalRenderer> controller;
+        controller.mainMenu();
+    }
+    else
+    {
+        std::cerr << "usage: " << argv[0] << " [terminal | null | record [file]]\n";
+        return 1;
+    }
     return 0;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <ctime>
 #include "../game/game_state.h"
 #include "save.h"
 
@@ -19,16 +20,18 @@ GameState Saves::saveFileToGameState(int saveNum)
     ifstream saveFile(savePathFile);
 
     saveFile >> state.rows >> state.cols;
-    state.board.resize(state.rows, vector<char> (state.cols));
+    state.board.resize(state.rows, state.cols);
     
+    char cell;
     for(int i = 0; i < state.rows; i++) 
     {
         for(int j = 0; j < state.cols; j++) 
         {
-            saveFile >> state.board[i][j];
+            saveFile >> cell;
             // Convert '_' from save file to empty spaces on board
-            if(state.board[i][j] == '_')
-                state.board[i][j] = ' ';
+            if(cell == '_')
+                cell = ' ';
+            state.board.set(i, j, cell);
         }
         
     }
@@ -51,6 +54,13 @@ GameState Saves::saveFileToGameState(int saveNum)
 
     saveFile >> state.numberOfPlayerTurns >> state.healthLost >> state.attackGained;
 
+    // Saves from before the random engine was saved carry on with a new seed
+    if (!(saveFile >> state.randomSeed >> state.randomPosition))
+    {
+        state.randomSeed = time(NULL);
+        state.randomPosition = 0;
+    }
+
     saveFile.close();
     return state;
 }
@@ -69,9 +79,10 @@ void Saves::gameStateToSaveFile(int saveNum, GameState& state)
         for(int j = 0; j < state.cols; j++) 
         {
             // Convert empty spaces from board to '_' on save file
-            if(state.board[i][j] == ' ')
-                state.board[i][j] = '_';
-            saveFile << state.board[i][j];
+            char cell = state.board.get(i, j);
+            if(cell == ' ')
+                cell = '_';
+            saveFile << cell;
         }
         saveFile << '\n';
     }
@@ -94,6 +105,7 @@ void Saves::gameStateToSaveFile(int saveNum, GameState& state)
     }
 
     saveFile << state.numberOfPlayerTurns <<  ' ' << state.healthLost << ' ' << state.attackGained << '\n';
+    saveFile << state.randomSeed << ' ' << state.randomPosition << '\n';
 
     saveFile.close();    
 }       